@@ -3,10 +3,15 @@
 #include "window.hpp"
 #include "new_game_dialog.hpp"
 #include "no_moves_left_dialog.hpp"
+#include "auto_player.hpp"
 #include "logic.hpp"
 #include "debug.hpp"
 
+#include <glibmm/dispatcher.h>
+
 #include <memory>
+#include <atomic>
+#include <thread>
 
 
 class Application : public Gtk::Application
@@ -81,6 +86,27 @@ private:
     index_t col
   );
 
+  /**
+   * @brief Place the mines for the first reveal on a worker thread, since the no guess search can take a while.
+   *
+   * @param row the row of the clicked tile
+   * @param col the column of the clicked tile
+   */
+  void startPlacingMines(
+    index_t row,
+    index_t col
+  );
+
+  /**
+   * @brief Reveal the first tile once the worker placed the mines.
+   */
+  void minesPlacedCallback();
+
+  /**
+   * @brief Cancel the search for a minefield started by the first reveal, e.g. because a new game gets started.
+   */
+  void stopPlacingMines();
+
   /**
    * @brief Attempts to flag the selected field and checks the game status.
    *
@@ -92,6 +118,60 @@ private:
     index_t col
   );
 
+# ifdef MW_DEBUG
+  /**
+   * @brief Describe a tile for the debug tooltip.
+   *
+   * @note The minefield is not read while the worker placing the mines may still be writing it.
+   *
+   * @param row the row of the hovered tile
+   * @param col the column of the hovered tile
+   *
+   * @returns the description of the tile
+   */
+  std::string tileDebugCallback(
+    index_t row,
+    index_t col
+  );
+# endif //defined(MW_DEBUG)
+
+  /* #endregion */
+  /* #region Auto Play Callbacks */
+
+  /**
+   * @brief Start or stop the auto player and update its move rate.
+   *
+   * @param is_active wether the auto player should be running
+   * @param moves_per_second moves per second, 0 for as fast as possible
+   */
+  void autoPlayCallback(
+    bool is_active,
+    index_t moves_per_second
+  );
+
+  /**
+   * @brief Display the moves made by the auto player.
+   *
+   * @param moves the moves to display
+   */
+  void autoPlayMovesCallback(
+    const std::vector<AutoPlayer::move_t> &moves
+  );
+
+  /**
+   * @brief Check the game status once the auto player stopped by itself.
+   *
+   * @param has_hit_mine wether the auto player revealed a mine
+   */
+  void autoPlayFinishedCallback(
+    bool has_hit_mine
+  );
+
+  /**
+   * @brief Stop the auto player, e.g. because the user took over.
+   */
+  void stopAutoPlay();
+
   /* #endregion */
   /* #region Game Control */
 
@@ -111,6 +191,15 @@ private:
    */
   bool newGame(NewGameDialog::Type type);
 
+  /**
+   * @brief Ask for a new game after a mine got revealed and undo the reveal if requested.
+   *
+   * @param cascade the tiles revealed together with the mine
+   */
+  void loseGame(
+    const Minefield::cascade_t &cascade
+  );
+
   /**
    * @brief Check and handle if the game if won or no more moves are available.
    */
@@ -123,9 +212,22 @@ private:
 
   std::unique_ptr<Window> window = nullptr;
   std::unique_ptr<Minefield> minefield = nullptr;
+  std::unique_ptr<AutoPlayer> auto_player = nullptr;
 
   std::shared_ptr<NewGameDialog> new_game_dialog = nullptr;
   std::shared_ptr<NoMovesLeftDialog> no_moves_left_dialog = nullptr;
 
   field_size_t current_field_size;
+  // wether new minefields have to be solvable without guessing
+  bool no_guess = false;
+
+  // first reveal waiting for the mines to be placed
+  index_t \
+    first_reveal_row = 0l,
+    first_reveal_col = 0l;
+  // set by the worker, reset once it has been joined, so a late dispatch of a cancelled worker gets ignored
+  std::atomic<bool> has_placed_mines = false;
+  Glib::Dispatcher mines_placed_dispatcher;
+  // declared last to be joined before the minefield gets destroyed
+  std::jthread mine_placer;
 };
\ No newline at end of file
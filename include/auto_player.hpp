@@ -0,0 +1,163 @@
+#pragma once
+
+#include "gui_defines.hpp"
+#include "logic.hpp"
+#include "debug.hpp"
+
+#include <glibmm/dispatcher.h>
+#include <sigc++/sigc++.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+class AutoPlayer
+{
+public:
+  typedef struct
+  {
+    index_t row, col;
+
+    // type of the revealed tile as in @ref `Minefield::tile_with_position_t`, ignored for flags
+    int type;
+    bool is_flag;
+  } move_t;
+
+  typedef sigc::slot<
+    void,
+    const std::vector<move_t> & /*moves*/
+  > moves_callback_t;
+
+  typedef sigc::slot<
+    void,
+    bool /*has_hit_mine*/
+  > finished_callback_t;
+
+public:
+  /**
+   * @brief Create an auto player for the minefield.
+   *
+   * @note Has to be created on the thread running the main loop, since the callbacks get called from it.
+   *
+   * @param minefield minefield to play on, must not be touched by anyone else while the auto player is running
+   * @param moves_callback callback receiving the moves to display
+   * @param finished_callback callback for when the auto player stopped by itself, i.e. because the game is won,
+   *                          it would have to guess or it hit a mine (because of a wrong flag)
+   */
+  AutoPlayer(
+    Minefield &minefield,
+    moves_callback_t moves_callback,
+    finished_callback_t finished_callback
+  );
+
+  /**
+   * @brief Start playing on a worker thread, does nothing if it is already running.
+   */
+  void start();
+
+  /**
+   * @brief Stop playing, e.g. because the user wants to take over.
+   *
+   * @note Blocks until the worker finished its current move. Moves that have not been displayed yet are handed to
+   *       the moves callback before returning, so the minefield and the window are in sync again. The finished
+   *       callback does not get called.
+   */
+  void stop();
+
+  /**
+   * @brief Check if the worker is currently playing.
+   *
+   * @returns true if the worker is running, false otherwise
+   */
+  bool isRunning();
+
+  /**
+   * @brief Set how fast the auto player plays.
+   *
+   * @param moves_per_second moves per second, 0 for as fast as the window keeps up
+   */
+  void setMoveRate(
+    index_t moves_per_second
+  );
+
+  /**
+   * @brief Get the tiles revealed by the last move, e.g. to undo it after the auto player hit a mine.
+   *
+   * @returns the revealed tiles
+   */
+  const Minefield::cascade_t &getLastCascade();
+
+private:
+  /**
+   * @brief Worker loop, deducing moves and posting them in batches until it is stopped or can not continue.
+   *
+   * @param stop_token token for stopping the worker
+   */
+  void play(
+    std::stop_token stop_token
+  );
+
+  /**
+   * @brief Hand the moves to the main loop and wait until it is time for the next batch.
+   *
+   * @param io_moves moves of the current batch, cleared afterwards
+   * @param io_deadline point in time the current batch is due, advanced to the next one
+   * @param stop_token token for stopping the worker
+   *
+   * @returns true if the worker may continue, false if it got stopped
+   */
+  bool postMoves(
+    std::vector<move_t> &io_moves,
+    std::chrono::steady_clock::time_point &io_deadline,
+    std::stop_token stop_token
+  );
+
+  /**
+   * @brief Get how many moves make up a batch and how long to wait between batches for the current move rate.
+   *
+   * @param o_batch_size moves per batch
+   * @param o_interval time between two batches
+   */
+  void getPace(
+    index_t &o_batch_size,
+    std::chrono::steady_clock::duration &o_interval
+  );
+
+  /**
+   * @brief Dispatcher callback running on the main loop, handing the posted moves to the moves callback.
+   */
+  void dispatchMoves();
+
+private:
+  MW_DECLARE_LOGGER;
+
+  Minefield &minefield;
+  moves_callback_t moves_callback;
+  finished_callback_t finished_callback;
+
+  std::atomic<index_t> moves_per_second = AUTO_PLAY_MOVES_PER_SECOND;
+
+  // moves waiting to be displayed, guarded by the mutex together with the finished state
+  std::mutex moves_mutex;
+  std::condition_variable_any moves_consumed;
+  std::vector<move_t> pending_moves;
+  bool \
+    has_finished = false,
+    has_hit_mine = false;
+
+  // moves currently being displayed, swapped with the pending ones so neither has to allocate again
+  std::vector<move_t> displayed_moves;
+
+  // only written by the worker, read once it has been joined
+  Minefield::cascade_t last_cascade;
+
+  Glib::Dispatcher dispatcher;
+
+  //! NOTE: declared last, so it gets stopped and joined before the members it uses are destroyed
+  std::jthread worker;
+};
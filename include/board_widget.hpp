@@ -0,0 +1,552 @@
+#pragma once
+
+#include "gui_defines.hpp"
+#include "sprite_atlas.hpp"
+#include "logic.hpp"
+#include "debug.hpp"
+
+#include <gtkmm.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+
+class BoardWidget : public Gtk::DrawingArea
+{
+public:
+  typedef sigc::slot<
+    void,
+    bool /*is_reveal*/,
+    index_t /*row*/,
+    index_t /*col*/
+  > callback_t;
+
+private:
+  //! NOTE: the first ten match the reveal sprites, i.e. mine, empty and the numbers 1-8
+  enum TileSprite : uint8_t
+  {
+    MINE = 0u, EMPTY = 1u,
+    UNTOUCHED = 10u, UNTOUCHED_HIGHLIGHTED,
+    FLAGGED, FLAGGED_HIGHLIGHTED,
+
+    NR_SPRITES
+  };
+
+  //! NOTE: tiles are only told apart by these when zoomed out too far for sprites
+  enum LodState : uint8_t
+  {
+    LOD_UNTOUCHED, LOD_REVEALED, LOD_FLAGGED, LOD_MINE,
+
+    NR_LOD_STATES
+  };
+
+  // number of tiles per state in an area
+  typedef std::array<uint32_t, LodState::NR_LOD_STATES> lod_counts_t;
+
+  // top left corner of a zoomed out pixel (or tile, if it is larger than one) relative to the board origin
+  typedef struct
+  {
+    double x, y;
+  } lod_pixel_t;
+
+public:
+  /**
+   * @brief Create a board showing all tiles of the minefield in a single widget.
+   *
+   * @note Does still need sprites and a field size.
+   *
+   * @param click_callback callback for when a tile gets clicked
+   */
+  BoardWidget(
+    callback_t click_callback
+  );
+
+  /**
+   * @brief Set the sprites, which get scaled to the tile size once per zoom level.
+   *
+   * @param reveal_sprites the sprites for mines (0), empty tiles (1) and the numbers 1-8 (2-9)
+   * @param flagged the normal and highlighted tile sprite for the flagged state
+   * @param untouched the normal and highlighted tile sprite for the untouched state
+   */
+  void setSprites(
+    const std::array<sprite_t, 10ul> &reveal_sprites,
+    const state_sprites_t &flagged,
+    const state_sprites_t &untouched
+  );
+
+  /**
+   * @brief Change the field size and reset all tiles.
+   *
+   * @note Tile storage is kept when shrinking and reused when growing again, so changing the size between games
+   *       only costs the tiles changed during the last game plus the difference in size.
+   *
+   * @param rows vertical field size
+   * @param cols horizontal field size
+   */
+  void resize(
+    index_t rows,
+    index_t cols
+  );
+
+  /**
+   * @brief Reset all tiles to untouched.
+   *
+   * @note Only the tiles changed since the last reset get touched.
+   */
+  void reset();
+
+  /**
+   * @brief Mark a tile as flagged or unflagged.
+   *
+   * @param row row / y coordinate
+   * @param col column / x coordinate
+   * @param flag wether to flag or unflag the tile
+   */
+  void setTileFlag(
+    index_t row,
+    index_t col,
+    bool flag
+  );
+
+  /**
+   * @brief Reveal all tiles of a cascade, invalidating the widget only once.
+   *
+   * @param cascade the revealed tiles
+   */
+  void revealTiles(
+    const Minefield::cascade_t &cascade
+  );
+
+  /**
+   * @brief Reset all tiles of a cascade to untouched, invalidating the widget only once.
+   *
+   * @param cascade the tiles to reset
+   */
+  void resetTiles(
+    const Minefield::cascade_t &cascade
+  );
+
+  /**
+   * @brief Get the adjustments the board gets scrolled with, e.g. to attach scrollbars to.
+   *
+   * @returns the horizontal or vertical adjustment
+   */
+  Glib::RefPtr<Gtk::Adjustment> getHAdjustment();
+  Glib::RefPtr<Gtk::Adjustment> getVAdjustment();
+
+# ifdef MW_DEBUG
+  void setInformationCallback(const sigc::slot<std::string, index_t, index_t> &callback);
+# endif //!defined(MW_DEBUG)
+
+protected:
+  /**
+   * @brief Draw the visible part of the board.
+   *
+   * @note Only tiles changed since the last draw get repainted into the backing surface, unless it got invalid
+   *       as a whole (e.g. by scrolling), which then gets copied to the widget.
+   *
+   * @param context cairo context of the widget
+   *
+   * @return true to stop other handlers from drawing
+   */
+  bool on_draw(const Cairo::RefPtr<Cairo::Context> &context) override;
+
+  void on_size_allocate(Gtk::Allocation &allocation) override;
+  bool on_button_press_event(GdkEventButton *button) override;
+  bool on_button_release_event(GdkEventButton *button) override;
+  bool on_motion_notify_event(GdkEventMotion *motion) override;
+  bool on_leave_notify_event(GdkEventCrossing *crossing) override;
+  bool on_scroll_event(GdkEventScroll *scroll) override;
+
+private:
+  /**
+   * @brief Set the sprite of a tile and schedule it for redrawing.
+   *
+   * @param idx index of the tile (row * cols + col)
+   * @param sprite the new sprite
+   */
+  void setTileSprite(
+    index_t idx,
+    uint8_t sprite
+  );
+
+  /**
+   * @brief Set the sprite of a tile and mark it dirty, without invalidating the widget yet.
+   *
+   * @param idx index of the tile (row * cols + col)
+   * @param sprite the new sprite
+   *
+   * @returns true if the dirty area grew and has to be invalidated, false otherwise
+   */
+  bool updateTileSprite(
+    index_t idx,
+    uint8_t sprite
+  );
+
+  /**
+   * @brief Mark a tile to be repainted on the next draw.
+   *
+   * @note Each tile is marked at most once per frame and all of them share a single bounding box, so applying a
+   *       large cascade stays linear in the number of tiles.
+   *
+   * @param idx index of the tile
+   *
+   * @returns true if the dirty area grew and has to be invalidated, false otherwise
+   */
+  bool markTileDirty(
+    index_t idx
+  );
+
+  /**
+   * @brief Mark the pixel of a changed tile to be repainted on the next draw while zoomed out.
+   *
+   * @note Tiles sharing a pixel only queue it once. Too many dirty pixels repaint the whole widget instead.
+   *
+   * @param x horizontal widget coordinate of the tile
+   * @param y vertical widget coordinate of the tile
+   * @param origin_x horizontal widget coordinate of the board origin
+   * @param origin_y vertical widget coordinate of the board origin
+   *
+   * @returns true if the pixel got queued, false if it already was or the whole widget gets repainted
+   */
+  bool markLodPixelDirty(
+    int x,
+    int y,
+    double origin_x,
+    double origin_y
+  );
+
+  /**
+   * @brief Forget all queued zoomed out pixels.
+   */
+  void clearDirtyLodPixels();
+
+  /**
+   * @brief Invalidate the area of all dirty tiles.
+   */
+  void invalidateDirtyArea();
+
+  /**
+   * @brief Paint a tile into the backing surface.
+   *
+   * @param context cairo context of the backing surface
+   * @param idx index of the tile
+   */
+  void drawTile(
+    const Cairo::RefPtr<Cairo::Context> &context,
+    index_t idx
+  );
+
+  /**
+   * @brief Get the tile under a point of the widget.
+   *
+   * @note Tiles can not be clicked or hovered while zoomed out too far for sprites.
+   *
+   * @param x horizontal widget coordinate
+   * @param y vertical widget coordinate
+   *
+   * @returns index of the tile, -1 if there is none (e.g. in the spacing between tiles or below the minimap)
+   */
+  index_t getTileAt(
+    double x,
+    double y
+  );
+
+  /**
+   * @brief Set which tile is highlighted because the pointer is above it.
+   *
+   * @note Only the previously and the newly hovered tile get repainted, and only if they have a highlighted
+   *       sprite at all.
+   *
+   * @param idx index of the tile, -1 for none
+   */
+  void setHoveredTile(
+    index_t idx
+  );
+
+  /**
+   * @brief Check if a sprite has a highlighted variant, which is shown while the pointer is above the tile.
+   *
+   * @param sprite the sprite of a tile
+   *
+   * @returns true for untouched and flagged tiles, false otherwise
+   */
+  static inline bool checkSpriteHighlightable(
+    uint8_t sprite
+  );
+
+  /**
+   * @brief Zoom in or out by a number of scroll steps.
+   *
+   * @note Sprites are zoomed continuously down to MIN_TILE_SIZE. Below that, each full step halves or doubles the
+   *       tile size down to a single pixel, and then the number of tiles per pixel, until the whole board fits.
+   *
+   * @param steps scroll steps, positive to zoom in
+   * @param anchor_x horizontal widget coordinate of the point to zoom around
+   * @param anchor_y vertical widget coordinate of the point to zoom around
+   */
+  void zoom(
+    double steps,
+    double anchor_x,
+    double anchor_y
+  );
+
+  /**
+   * @brief Set the zoom level, keeping the tile under the anchor point in place.
+   *
+   * @param tile_size new size of a tile in pixels, at least MIN_TILE_SIZE to draw sprites
+   * @param lod_shift two to the power of it tiles share a pixel in each direction, requires a tile size of 1
+   * @param anchor_x horizontal widget coordinate of the anchor
+   * @param anchor_y vertical widget coordinate of the anchor
+   */
+  void setZoom(
+    int tile_size,
+    int lod_shift,
+    double anchor_x,
+    double anchor_y
+  );
+
+  /**
+   * @brief Check if the board is zoomed out too far for sprites, i.e. is drawn with plain colors.
+   *
+   * @returns true if zoomed out that far, false otherwise
+   */
+  inline bool checkLevelOfDetail();
+
+  /**
+   * @brief Convert a distance on the board from tiles to pixels at the current zoom level.
+   *
+   * @param tiles distance in tiles
+   *
+   * @returns distance in pixels
+   */
+  inline double toPixels(
+    double tiles
+  );
+
+  /**
+   * @brief Convert a distance on the board from pixels to tiles at the current zoom level.
+   *
+   * @param pixels distance in pixels
+   *
+   * @returns distance in tiles
+   */
+  inline double toTiles(
+    double pixels
+  );
+
+  /**
+   * @brief Paint an area of the zoomed out board, where each pixel shows the blended colors of its tiles.
+   *
+   * @param x0 left edge in widget coordinates
+   * @param y0 top edge in widget coordinates
+   * @param x1 right edge in widget coordinates (exclusive)
+   * @param y1 bottom edge in widget coordinates (exclusive)
+   */
+  void drawLevelOfDetail(
+    int x0,
+    int y0,
+    int x1,
+    int y1
+  );
+
+  /**
+   * @brief Move what is already painted of the zoomed out board after scrolling and paint the uncovered parts.
+   *
+   * @param delta_x horizontal distance the board moved in pixels
+   * @param delta_y vertical distance the board moved in pixels
+   */
+  void scrollLevelOfDetail(
+    int delta_x,
+    int delta_y
+  );
+
+  /**
+   * @brief Blend the colors of the tile states by their counts.
+   *
+   * @param counts number of tiles per state
+   *
+   * @returns the color as premultiplied cairo ARGB32 pixel, transparent for no tiles
+   */
+  static uint32_t blendLodColor(
+    const lod_counts_t &counts
+  );
+
+  /**
+   * @brief Get what a sprite looks like when zoomed out.
+   *
+   * @param sprite the sprite of a tile
+   *
+   * @returns the state of the tile
+   */
+  static inline LodState getLodState(
+    uint8_t sprite
+  );
+
+  /**
+   * @brief Recalculate the minimap layout for the field size and set all of its tiles to untouched.
+   */
+  void resetMinimap();
+
+  /**
+   * @brief Update the minimap pixel of a tile whose sprite changed.
+   *
+   * @param idx index of the tile
+   * @param old_sprite the sprite before the change
+   * @param new_sprite the sprite after the change
+   *
+   * @returns true if the minimap changed and has to be invalidated, false otherwise
+   */
+  bool updateMinimap(
+    index_t idx,
+    uint8_t old_sprite,
+    uint8_t new_sprite
+  );
+
+  /**
+   * @brief Draw the minimap and the visible part of the board on it into the lower right corner.
+   *
+   * @param context cairo context of the widget
+   */
+  void drawMinimap(
+    const Cairo::RefPtr<Cairo::Context> &context
+  );
+
+  /**
+   * @brief Get where the minimap is drawn and how large its pixels are drawn.
+   *
+   * @param o_x horizontal widget coordinate of the left edge
+   * @param o_y vertical widget coordinate of the top edge
+   * @param o_scale drawn size of a minimap pixel
+   *
+   * @returns true if the minimap is shown, i.e. the board does not fit into the widget, false otherwise
+   */
+  bool getMinimapArea(
+    double &o_x,
+    double &o_y,
+    double &o_scale
+  );
+
+  /**
+   * @brief Check if a point lies on the shown minimap.
+   *
+   * @param x horizontal widget coordinate
+   * @param y vertical widget coordinate
+   *
+   * @returns true if the point is on the minimap, false otherwise
+   */
+  bool checkMinimapAt(
+    double x,
+    double y
+  );
+
+  /**
+   * @brief Scroll the board so the point of the minimap is in the center of the widget.
+   *
+   * @param x horizontal widget coordinate
+   * @param y vertical widget coordinate
+   */
+  void scrollToMinimap(
+    double x,
+    double y
+  );
+
+  /**
+   * @brief Get the widget coordinates of the top left corner of the first tile.
+   *
+   * @note Boards smaller than the widget are centered, larger ones are shifted by the scroll position.
+   *
+   * @param o_x horizontal widget coordinate
+   * @param o_y vertical widget coordinate
+   */
+  void getOrigin(
+    double &o_x,
+    double &o_y
+  );
+
+  /**
+   * @brief Update the scroll ranges to the field and widget size.
+   */
+  void updateAdjustments();
+
+private:
+  MW_DECLARE_LOGGER;
+
+  callback_t click_callback;
+
+  field_size_t field_size;
+  std::vector<uint8_t> tile_sprites;
+
+  // tiles changed from untouched since the last reset, may contain a tile more than once if it got unflagged
+  std::vector<index_t> changed_tiles;
+  index_t hovered_idx = -1l;
+
+  // last pointer position, so the hovered tile can be updated while scrolling
+  double \
+    pointer_x = -1.,
+    pointer_y = -1.;
+
+  // current zoom level, the spacing between tiles scales with it and is gone before sprites get too small
+  int \
+    tile_size    = TILE_SIZE,
+    tile_spacing = SPACING,
+    tile_pitch   = TILE_SIZE + SPACING,
+    lod_shift    = 0;
+
+  // scroll steps towards the next level of detail, which only changes in full steps
+  double lod_zoom_steps = 0.;
+
+  // all sprites scaled to the tile size, the one of the current zoom level is only looked up once per frame
+  SpriteAtlas sprite_atlas;
+  Cairo::RefPtr<Cairo::ImageSurface> atlas_surface;
+
+  // visible part of the board, only changed tiles get repainted into it unless it is invalid as a whole
+  Cairo::RefPtr<Cairo::Surface> backing_surface;
+  int \
+    backing_width  = 0,
+    backing_height = 0;
+  bool is_backing_valid = false;
+
+  // takes the place of the backing surface when zoomed out, its pixels get written directly
+  Cairo::RefPtr<Cairo::ImageSurface> lod_surface;
+  double \
+    lod_origin_x = 0.,
+    lod_origin_y = 0.;
+
+  // zoomed out pixels to repaint on the next draw, each queued at most once
+  std::vector<lod_pixel_t> dirty_lod_pixels;
+  std::vector<bool> is_lod_pixel_dirty;
+
+  // reused buffers for painting a row of pixels
+  std::vector<index_t> lod_first_cols;
+  std::vector<lod_counts_t> lod_row_counts;
+
+  // tiles to repaint into the backing surface on the next draw, each queued at most once
+  std::vector<index_t> dirty_tiles;
+  std::vector<bool> is_tile_dirty;
+
+  // bounding box of the dirty tiles in widget coordinates, empty if x0 >= x1
+  int \
+    dirty_x0 = 0,
+    dirty_y0 = 0,
+    dirty_x1 = 0,
+    dirty_y1 = 0;
+
+  // one pixel per square block of tiles, kept up to date with every changed tile
+  index_t \
+    minimap_block = 1l,
+    minimap_rows  = 0l,
+    minimap_cols  = 0l;
+  std::vector<lod_counts_t> minimap_counts;
+  Cairo::RefPtr<Cairo::ImageSurface> minimap_surface;
+  bool \
+    is_minimap_dirty    = false,
+    is_minimap_dragging = false;
+
+  Glib::RefPtr<Gtk::Adjustment> \
+    h_adjustment,
+    v_adjustment;
+
+  static const std::array<uint32_t, LodState::NR_LOD_STATES> lod_colors;
+};
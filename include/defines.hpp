@@ -1,56 +1,34 @@
 #pragma once
 
 #include <cstddef>
-#include <glibmm/refptr.h>
-#include <gdkmm/pixbuf.h>
+#include <cstdint>
 
-/* #region graphical configs */
-
-#define SPACING 5l
-
-#define TILE_SIZE 50l
-
-#define MIN_FIELD_ROWS 10l
-#define MIN_FIELD_COLS 10l
-
-/*
-#define COLOR_FIELD_1 "ddfac3"
-#define COLOR_FIELD_2 "dfeaba"
-#define COLOR_FIELD_3 "e1dab2"
-#define COLOR_FIELD_4 "e3caaa"
-#define COLOR_FIELD_5 "e6baa2"
-#define COLOR_FIELD_6 "e8aa9a"
-#define COLOR_FIELD_7 "ea9a92"
-#define COLOR_FIELD_8 "ed8a8a"
-*/
-
-/* #endregion */
 /* #region general configs */
 
 #define DEFAULT_BOMB_FACTOR .1563
 
 #define MIN_INITIAL_FIELDS 7l
 
-/* #endregion */
-/* #region build context */
+// time the search for a minefield that can be solved without guessing may take before falling back to a random one
+#define NO_GUESS_TIME_BUDGET_MS 50l
 
-#ifndef PROGRAM_NAME
-#define PROGRAM_NAME "[UNKNOWN]"
-#endif // !defined(PROGRAM_NAME)
+// backtracking steps spent on a single frontier component before its constraints get ignored instead
+#define PROBABILITY_MAX_ENUMERATION_NODES 200000ull
 
-#ifndef EXECUTABLE_NAME
-#error No executable name defined.
-#endif // !defined(EXECUTABLE_NAME)
+// games the simulator hands out per task, small enough for idle workers to find something to steal
+#define SIMULATOR_GAMES_PER_TASK 16ull
 
-#ifndef SPRITE_DIRECTORY
-#error No sprite directory defined.
-#endif // !defined(SPRITE_DIRECTORY)
+// alignment of data written by different threads, std::hardware_destructive_interference_size is not ABI stable
+#define CACHE_LINE_SIZE 64ul
 
 /* #endregion */
 /* #region general resources */
 
 typedef int64_t index_t;
 
+// seed of the random generator a minefield gets generated with
+typedef uint64_t seed_t;
+
 typedef struct
 {
   index_t \
@@ -58,9 +36,4 @@ typedef struct
     cols = 0l;
 } field_size_t;
 
-typedef Glib::RefPtr<Gdk::Pixbuf> sprite_t;
-typedef struct {
-  sprite_t normal, highlighted;
-} state_sprites_t;
-
-/* #endregion */
\ No newline at end of file
+/* #endregion */
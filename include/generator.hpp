@@ -0,0 +1,75 @@
+#pragma once
+
+#include "debug.hpp"
+#include "defines.hpp"
+
+#include <cstdint>
+#include <chrono>
+#include <stop_token>
+
+
+class NoGuessGenerator
+{
+public:
+  /**
+   * @brief Create a generator for minefields of the given size.
+   *
+   * @param rows minefield height
+   * @param cols minefield width
+   * @param mine_density mines per tile, see @ref `Minefield::setMineDensity`
+   * @param initial_patch_size free tiles around the first reveal, see @ref `Minefield::setInitialPatchSize`
+   * @param time_budget time after which the search gives up
+   */
+  NoGuessGenerator(
+    index_t rows,
+    index_t cols,
+    double mine_density = DEFAULT_BOMB_FACTOR,
+    index_t initial_patch_size = MIN_INITIAL_FIELDS,
+    std::chrono::milliseconds time_budget = std::chrono::milliseconds(NO_GUESS_TIME_BUDGET_MS)
+  );
+
+  /**
+   * @brief Search for a seed whose minefield can be solved without guessing from the given first reveal.
+   *
+   * @note Candidate seeds are derived from the base seed and checked on all cores. The candidate with the lowest
+   *       number wins, so the result only depends on the arguments as long as the search finishes in time.
+   *
+   * @param row row / y coordinate of the first revealed tile
+   * @param col column / x coordinate of the first revealed tile
+   * @param base_seed seed the candidates are derived from, it is the first candidate itself
+   * @param o_seed seed of the found minefield
+   * @param stop_token token to cancel the search from another thread
+   *
+   * @returns true if a seed was found, false if the search was cancelled or ran out of time
+   */
+  bool findSeed(
+    index_t row,
+    index_t col,
+    seed_t base_seed,
+    seed_t &o_seed,
+    std::stop_token stop_token = {}
+  );
+
+private:
+  /**
+   * @brief Derive the seed of a candidate.
+   *
+   * @param base_seed seed the candidates are derived from
+   * @param candidate_idx number of the candidate
+   *
+   * @returns the candidate seed
+   */
+  static seed_t getCandidateSeed(
+    seed_t base_seed,
+    uint64_t candidate_idx
+  );
+
+private:
+  MW_DECLARE_LOGGER;
+
+  index_t rows, cols;
+  double mine_density;
+  index_t initial_patch_size;
+  std::chrono::milliseconds time_budget;
+  unsigned int nr_threads;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "defines.hpp"
+
+#include <glibmm/refptr.h>
+#include <gdkmm/pixbuf.h>
+
+/* #region graphical configs */
+
+#define SPACING 5l
+
+#define TILE_SIZE 50l
+
+// tile sizes the board can be zoomed to with control + scrolling
+#define MIN_TILE_SIZE 8l
+#define MAX_TILE_SIZE 200l
+// factor the tile size changes by per scroll step
+#define ZOOM_STEP 1.25
+// zoom levels whose scaled sprites are kept around
+#define SPRITE_ATLAS_CACHE_SIZE 4ul
+// zooming out further than MIN_TILE_SIZE draws plain colors, at most 2^MAX_LOD_SHIFT tiles per pixel and direction
+#define MAX_LOD_SHIFT 12l
+
+// colors (0xRRGGBB) of zoomed out tiles and the minimap, blended by how many tiles of an area are in which state
+#define LOD_COLOR_UNTOUCHED 0x9a9a9au
+#define LOD_COLOR_REVEALED  0xe4e4e4u
+#define LOD_COLOR_FLAGGED   0xd8453bu
+#define LOD_COLOR_MINE      0x202020u
+
+// longer side of the minimap shown for boards larger than the window
+#define MINIMAP_SIZE 160l
+
+#define MIN_FIELD_ROWS 10l
+#define MIN_FIELD_COLS 10l
+// the board scrolls and zooms, so this only bounds memory (a few bytes per tile in logic and board)
+#define MAX_FIELD_ROWS 10000l
+#define MAX_FIELD_COLS 10000l
+
+// moves the auto player makes per second by default, 0 lets it play as fast as the window keeps up
+#define AUTO_PLAY_MOVES_PER_SECOND 20l
+// how often per second the moves get handed to the window
+#define AUTO_PLAY_BATCHES_PER_SECOND 60l
+// tiles that may wait to be displayed before the auto player holds off, which bounds the work per batch
+#define AUTO_PLAY_MAX_PENDING_TILES 512ul
+
+/*
+#define COLOR_FIELD_1 "ddfac3"
+#define COLOR_FIELD_2 "dfeaba"
+#define COLOR_FIELD_3 "e1dab2"
+#define COLOR_FIELD_4 "e3caaa"
+#define COLOR_FIELD_5 "e6baa2"
+#define COLOR_FIELD_6 "e8aa9a"
+#define COLOR_FIELD_7 "ea9a92"
+#define COLOR_FIELD_8 "ed8a8a"
+*/
+
+/* #endregion */
+/* #region build context */
+
+#ifndef PROGRAM_NAME
+#define PROGRAM_NAME "[UNKNOWN]"
+#endif // !defined(PROGRAM_NAME)
+
+#ifndef EXECUTABLE_NAME
+#error No executable name defined.
+#endif // !defined(EXECUTABLE_NAME)
+
+#ifndef SPRITE_DIRECTORY
+#error No sprite directory defined.
+#endif // !defined(SPRITE_DIRECTORY)
+
+/* #endregion */
+/* #region graphical resources */
+
+typedef Glib::RefPtr<Gdk::Pixbuf> sprite_t;
+typedef struct {
+  sprite_t normal, highlighted;
+} state_sprites_t;
+
+/* #endregion */
@@ -2,13 +2,23 @@
 
 #include "debug.hpp"
 #include "defines.hpp"
+#include "random.hpp"
 
 #include <cstdlib>
 #include <cstdint>
 #include <vector>
 #include <array>
 #include <optional>
-#include <sigc++/sigc++.h>
+#include <string>
+#include <stop_token>
+#include <concepts>
+
+
+/**
+ * @brief Callable to be applied to a tile, e.g. the surrounding tiles of a source tile.
+ */
+template<typename visitor_t, typename tile_type>
+concept tile_visitor = std::invocable<visitor_t, tile_type &>;
 
 class Minefield
 {
@@ -30,23 +40,54 @@ public:
     ALREADY_REVEALED
   };
 
+  enum class TileState
+  {
+    UNTOUCHED, FLAGGED, REVEALED,
+
+    NO_OPT
+  };
+
+  typedef struct
+  {
+    TileState state;
+
+    // number (1-8), empty (0) or mine (-1); only meaningful if revealed
+    int type;
+  } tile_info_t;
+
+  enum class GenerationMode
+  {
+    RANDOM,  // mines are placed randomly, only the initial patch is guaranteed to be free
+    NO_GUESS // the minefield can be solved from the first revealed tile without guessing
+  };
+
+  enum class CountKernel
+  {
+    SCATTER, // increment the counts around every placed mine
+    BOX_SUM  // sum up a 3x3 box of the mine plane for every tile after placing all mines
+  };
+
 private:
+  //! NOTE: packed into 16 bits so that full field passes only have to pull 2 bytes per tile through the cache
   typedef struct
   {
     // semi constant
-    bool is_mine = false;
-    uint8_t nr_surrounding_mines = 0u;
+    uint16_t \
+      is_mine               : 1 = false,
+      nr_surrounding_mines  : 4 = 0u;
 
     // toggleable
-    bool \
-      is_flagged  = false,
-      is_revealed = false;
+    uint16_t \
+      is_flagged  : 1 = false,
+      is_revealed : 1 = false;
 
     // runtime
-    uint8_t \
-      nr_surrounding_flags      = 0u,
-      nr_surrounding_untouched  = 8u;
+    uint16_t \
+      nr_surrounding_flags      : 4 = 0u,
+      nr_surrounding_untouched  : 4 = 8u,
+      is_actionable             : 1 = false; // revealed tile offering a move, see updateTileActionable
   } tile_t;
+  static_assert(sizeof(tile_t) == sizeof(uint16_t), "tile_t is expected to be packed into 16 bits");
   friend std::ostream &operator<<(std::ostream &stream, const tile_t &tile);
 
   typedef struct
@@ -62,13 +103,11 @@ private:
     int64_t rows, cols;
   } tile_offset_t;
 
-  /**
-   * @param tile the currently selected adjacent tile
-   * @param user_data custom data given to the callback
-   *
-   * @returns true if the loop for be exited, false otherwise
-   */
-  typedef bool (*for_surrounding_tiles_callback_t)(tile_t &tile, void *user_data);
+  typedef struct
+  {
+    // field indices of the first and last tile of a horizontal run of empty tiles
+    index_t left, right;
+  } cascade_span_t;
 
 public:
   /* #region minefield generation */
@@ -76,12 +115,16 @@ public:
   /**
    * @brief Create the minefield of given size and set it up for on demand initialization.
    *
+   * @note The same seed, field size and first revealed tile always result in the same minefield.
+   *
    * @param rows new minefield height
    * @param cols new minefield width
+   * @param seed seed for the first minefield, a random one is drawn if none is given
    */
   Minefield(
     index_t rows,
-    index_t cols
+    index_t cols,
+    std::optional<seed_t> seed = std::nullopt
   );
 
   /**
@@ -89,20 +132,84 @@ public:
    *
    * @param rows new minefield height
    * @param cols new minefield width
+   * @param seed seed for the next minefield, a random one is drawn if none is given
    */
   void resize(
     index_t rows,
-    index_t cols
+    index_t cols,
+    std::optional<seed_t> seed = std::nullopt
   );
 
   /**
    * @brief Set the field up for on demand initialization
+   *
+   * @param seed seed for the next minefield, a random one is drawn if none is given
    */
-  void reset();
+  void reset(
+    std::optional<seed_t> seed = std::nullopt
+  );
+
+  /**
+   * @brief Select how the mines get placed when the field is initialized.
+   *
+   * @note If no minefield without guessing is found in time, the first revealed tile falls back to a random one.
+   *
+   * @param mode generation mode to use from the next initialization on
+   */
+  void setGenerationMode(
+    GenerationMode mode
+  );
+
+  /**
+   * @brief Select how the surrounding mine counts get computed when the field is initialized.
+   *
+   * @param kernel count kernel to use from the next initialization on
+   */
+  void setCountKernel(
+    CountKernel kernel
+  );
+
+  /**
+   * @brief Set the share of tiles that are mines.
+   *
+   * @note Takes effect with the next reset or resize, or immediately if the field is not initialized yet.
+   *
+   * @param mine_density mines per tile, between 0 and 1
+   */
+  void setMineDensity(
+    double mine_density
+  );
+
+  /**
+   * @brief Set the minimum number of tiles around the first revealed tile that are guaranteed to be free.
+   *
+   * @param initial_patch_size number of free tiles to use from the next initialization on
+   */
+  void setInitialPatchSize(
+    index_t initial_patch_size
+  );
 
   /* #endregion */
   /* #region field manipulation */
 
+  /**
+   * @brief Place the mines around the first revealed tile, done by @ref `revealTile` if the field is not initialized.
+   *
+   * @note In no guess mode this searches for a solvable minefield for up to NO_GUESS_TIME_BUDGET_MS, so callers on
+   *       the main loop should run it on a worker thread and keep a way to cancel it.
+   *
+   * @param row row / y coordinate of the first revealed tile
+   * @param col column / x coordinate of the first revealed tile
+   * @param stop_token token to cancel the no guess search from another thread
+   *
+   * @returns true if the mines got placed, false if the position was invalid or the search got cancelled
+   */
+  bool placeMines(
+    index_t row,
+    index_t col,
+    std::stop_token stop_token = {}
+  );
+
   /**
    * @brief Attempt to reveal the field and maybe set of a reveal cascade.
    *
@@ -151,6 +258,9 @@ public:
   /**
    * @brief Help the user by revealing fields until they have available moves again.
    *
+   * @note Only the unrevealed tiles next to revealed numbers are looked at, preferring the safe ones that make the
+   *       most numbers actionable, so only a few tiles get revealed per help.
+   *
    * @param o_revealed_fields vector of tiles that got revealed in cascade
    */
   void revealTilesForUser(
@@ -161,7 +271,9 @@ public:
   /* #region status checks */
 
   /**
-   * @brief Check if all non-mine fields are revealed.
+   * @brief Check if all non-mine fields are revealed or all mines are flagged.
+   *
+   * @note Runs in constant time, the counters are kept up to date by every reveal, undo and flag toggle.
    *
    * @returns true if the check succeded, false otherwise
    */
@@ -170,10 +282,19 @@ public:
   /**
    * @brief Check if there are any "reasonable" moves left.
    *
+   * @note Runs in constant time, the actionable tiles are tracked by every reveal, undo and flag toggle.
+   *
    * @returns true if the check succeded, false otherwise
    */
   bool checkHasAvailableMoves();
 
+  /**
+   * @brief Check if the mines have been placed, which happens upon the first reveal.
+   *
+   * @returns true if the field is initialized, false otherwise
+   */
+  bool checkFieldInitialized();
+
   /* #endregion */
   /* #region getters */
 
@@ -184,6 +305,35 @@ public:
    */
   const index_t &getNrMines();
 
+  /**
+   * @brief Get the dimensions of the current field.
+   *
+   * @returns rows and columns of the field
+   */
+  const field_size_t &getFieldSize();
+
+  /**
+   * @brief Get the seed the current minefield is (or will be on the first reveal) generated with.
+   *
+   * @returns seed of the current minefield
+   */
+  seed_t getSeed();
+
+  /**
+   * @brief Get the publicly visible information about a tile, i.e. without leaking unrevealed mines.
+   *
+   * @param row row / y coordinate
+   * @param col column / x coordinate
+   * @param o_info state of the tile and its type if it is revealed
+   *
+   * @returns true if the position was valid, false otherwise
+   */
+  bool getTileInfo(
+    index_t row,
+    index_t col,
+    tile_info_t &o_info
+  );
+
 # ifdef MW_DEBUG
   std::string getTileString(index_t row, index_t col);
 # endif //defined(MW_DEBUG)
@@ -204,6 +354,59 @@ private:
     index_t col
   );
 
+  /**
+   * @brief Recalculate the padded field dimensions and neighbor offsets for the current field size.
+   */
+  void updateFieldLayout();
+
+  /**
+   * @brief Set the seed for the next minefield.
+   *
+   * @note The OS entropy is only queried the first time no seed is given, every further seed is drawn from the
+   *       seed source.
+   *
+   * @param seed seed to use, the next one of @ref `seed_source` if none is given
+   */
+  void updateSeed(
+    std::optional<seed_t> seed
+  );
+
+  /**
+   * @brief Label all openings (connected areas of empty tiles) and store their tiles plus border contiguously.
+   *
+   * @note Has to be called after the mines and their counts have been placed.
+   */
+  void buildOpeningIndex();
+
+  /**
+   * @brief Compute the surrounding mine counts of all tiles from their is_mine bits.
+   *
+   * @note Walks the field row by row, keeping only three rows of the mine plane around at a time.
+   */
+  void countSurroundingMines();
+
+  /**
+   * @brief Sum up the mines around every tile of a row of the padded field.
+   *
+   * @note The tile itself is excluded. All rows have to be @p width bytes long, only the
+   *       entries 1 to width - 2 of @p o_counts are written.
+   *
+   * @param above mine plane of the row above
+   * @param current mine plane of the row
+   * @param below mine plane of the row below
+   * @param sums scratch buffer for the column sums
+   * @param o_counts surrounding mine counts of the row
+   * @param width padded row width
+   */
+  static void sumSurroundingMines(
+    const uint8_t *above,
+    const uint8_t *current,
+    const uint8_t *below,
+    uint8_t *sums,
+    uint8_t *o_counts,
+    index_t width
+  );
+
   /* #endregion */
   /* #region field manipulation */
 
@@ -223,20 +426,72 @@ private:
   );
 
   /**
-   * @brief Give all valid surrounding tiles to callback.
+   * @brief Reveal a single tile and, if it is empty, flood fill the connected empty area and its border.
+   *
+   * @note Flagged and already revealed tiles are left untouched.
    *
-   * @note No range checks are performed on the source tile.
+   * @param idx index of the tile inside the padded field
+   * @param o_revealed_fields vector the revealed tiles get appended to
    *
-   * @param row row / y coordinate of source tile
-   * @param col column / x coordinate of source tile
-   * @param callback function to apply to surrounding tiles
-   * @param user_data data pointer to be reinterpreted by the callback
+   * @returns true if the tile was a mine, false otherwise
    */
-  void forSurroundingMines(
-    index_t row,
-    index_t col,
-    for_surrounding_tiles_callback_t callback,
-    void *user_data = nullptr
+  bool revealCascade(
+    index_t idx,
+    cascade_t &o_revealed_fields
+  );
+
+  /**
+   * @brief Reveal the whole horizontal run of empty tiles around the seed tile plus its left and right border
+   *        and queue it for scanning the rows above and below.
+   *
+   * @note The seed tile has to be an unrevealed, unflagged empty tile.
+   *
+   * @param seed_idx index of the seed tile inside the padded field
+   * @param o_revealed_fields vector the revealed tiles get appended to
+   *
+   * @returns the index of the last tile of the run
+   */
+  index_t pushCascadeSpan(
+    index_t seed_idx,
+    cascade_t &o_revealed_fields
+  );
+
+  /**
+   * @brief Mark a single tile as revealed, update its surrounding tiles and record it.
+   *
+   * @note No checks are performed on the tile.
+   *
+   * @param idx index of the tile inside the padded field
+   * @param o_revealed_fields vector the revealed tile gets appended to
+   */
+  inline void revealSingleTile(
+    index_t idx,
+    cascade_t &o_revealed_fields
+  );
+
+  /**
+   * @brief Rate how much revealing a safe tile would help a user without available moves.
+   *
+   * @param idx index of the tile inside the padded field
+   *
+   * @returns higher values for tiles making more revealed numbers actionable
+   */
+  inline int scoreHelpCandidate(
+    index_t idx
+  );
+
+  /**
+   * @brief Apply the visitor to all surrounding tiles.
+   *
+   * @note No range checks are performed on the source tile. Sentinel tiles are handed to the visitor as well.
+   *
+   * @param idx index of the source tile inside the padded field
+   * @param visitor callable to apply to surrounding tiles
+   */
+  template<tile_visitor<tile_t> visitor_t>
+  inline void forSurroundingTiles(
+    index_t idx,
+    visitor_t &&visitor
   );
 
   /* #endregion */
@@ -268,12 +523,37 @@ private:
     const tile_t &tile
   );
 
+  /**
+   * @brief Recheck if a tile offers a move and update @ref `actionable_tiles_count` accordingly.
+   *
+   * @note Has to be called whenever the state or one of the counters of the tile changed.
+   *
+   * @param tile tile to be rechecked
+   */
+  inline void updateTileActionable(
+    tile_t &tile
+  );
+
+  /**
+   * @brief Add a tile to the border tiles if it became a revealed number with untouched surrounding tiles.
+   *
+   * @note Tiles leaving the border stay listed until the next pruning, which happens whenever the list doubled, so
+   *       it only ever holds a constant factor more tiles than the actual border.
+   *
+   * @param tile the tile to check, has to be part of the field
+   */
+  inline void updateTileBorder(
+    tile_t &tile
+  );
+
   /* #endregion*/
   /* #region getters */
 
   /**
    * @brief Calculate number of mines from field count.
    *
+   * @note Capped so the initial patch still fits next to the mines.
+   *
    * @returns number of mines
    */
   inline index_t calculateNrOfMines();
@@ -293,6 +573,45 @@ private:
     index_t col
   );
 
+  /**
+   * @brief Get the index of the specified position inside the padded field.
+   *
+   * @note No range checks are performed.
+   *
+   * @param row row / y coordinate
+   * @param col column / x coordinate
+   *
+   * @returns the index into @ref `field`
+   */
+  inline index_t getTileIndex(
+    index_t row,
+    index_t col
+  );
+
+  /**
+   * @brief Get the position of the tile at the specified index inside the padded field.
+   *
+   * @param idx index into @ref `field`
+   *
+   * @returns the row and column of the tile
+   */
+  inline tile_position_t getTilePosition(
+    index_t idx
+  );
+
+  /**
+   * @brief Get the label of the opening an empty tile belongs to.
+   *
+   * @note No checks are performed, the tile has to be empty and the opening index has to exist.
+   *
+   * @param idx index into @ref `field`
+   *
+   * @returns the opening index + 1, or 0 while the index is being built and the tile has not been reached yet
+   */
+  inline uint32_t &getOpeningLabel(
+    index_t idx
+  );
+
   /* #endregion */
 
 private:
@@ -302,10 +621,66 @@ private:
   index_t nr_of_mines;
 
   index_t field_size;
-  std::vector<tile_t> field;
   bool field_initialized = false;
+  GenerationMode generation_mode = GenerationMode::RANDOM;
+  CountKernel count_kernel = CountKernel::BOX_SUM;
+  double mine_density = DEFAULT_BOMB_FACTOR;
+  index_t initial_patch_size = MIN_INITIAL_FIELDS;
+
+  // seed of the current minefield and the generator the seeds are drawn from if the user does not provide one
+  seed_t seed;
+  // only seeded from the OS entropy once the first seed has to be drawn from it
+  std::optional<Xoshiro256> seed_source;
+
+  // running counters for the win check
+  index_t \
+    revealed_tiles_count          = 0l, // non-mine tiles only
+    correctly_flagged_mines_count = 0l;
+
+  // number of tiles with `is_actionable` set, so the "no moves left" check does not need to scan the field
+  index_t actionable_tiles_count = 0l;
+
+  /**
+   * The field is surrounded by a one tile wide ring of sentinel tiles, so neighbors can be
+   * accessed with fixed index offsets and without any bounds checks.
+   */
+  std::vector<tile_t> field;
+  index_t field_stride;
+  std::array<index_t, 8ul> neighbor_offsets;
+
+  // reusable work buffer for reveal cascades, so clicks don't allocate once it has grown
+  std::vector<cascade_span_t> cascade_stack;
+
+  // revealed numbers with untouched surrounding tiles, each listed once; tiles that left the border get pruned
+  // once the list reaches border_tiles_prune_size
+  std::vector<index_t> border_tiles;
+  std::vector<bool> is_border_listed;
+  size_t border_tiles_prune_size = 0ul;
+
+  // safe tiles not revealed yet, collected the first time the help runs out of border tiles and pruned lazily
+  std::vector<index_t> unrevealed_safe_tiles;
+  bool has_unrevealed_safe_tiles = false;
+
+  /**
+   * Precomputed openings: the empty tiles and the numbered border of opening `i` are stored in
+   * `opening_tiles[opening_offsets[i] ... opening_offsets[i + 1]]`. Flags set on empty tiles invalidate the
+   * precomputed span of their opening, since they stop the cascade.
+   *
+   * Only empty tiles have a label (`i + 1`), so the labels are stored densely in field order and looked up by the
+   * rank of the tile among the empty ones: bit `idx` of `empty_tile_bits` marks empty tiles and
+   * `empty_tile_ranks[word]` counts the set bits before that word. That takes about 1.5 bits per tile plus 4 bytes
+   * per empty tile instead of 4 bytes per tile.
+   */
+  std::vector<uint32_t> \
+    opening_labels,
+    opening_tiles,
+    opening_flag_counts;
+  std::vector<size_t> opening_offsets;
+  std::vector<uint64_t> empty_tile_bits;
+  std::vector<uint32_t> empty_tile_ranks;
+  bool has_opening_index = false;
 
   static tile_t default_tile;
-  static const std::array<tile_offset_t, 8ul> offsets;
+  static const tile_t sentinel_tile;
   static const std::array<tile_offset_t, 4ul> directions;
 };
\ No newline at end of file
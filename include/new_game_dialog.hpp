@@ -1,6 +1,6 @@
 #pragma once
 
-#include "defines.hpp"
+#include "gui_defines.hpp"
 #include "debug.hpp"
 
 #include <gtkmm.h>
@@ -36,19 +36,17 @@ public:
    * @brief Run the dialog.
    *
    * @param type The type of information to show about the game state.
-   * @param io_rows user selected rows; initial value gets reflected in the scale
-   * @param max_rows the upper soft limit for the number of rows
-   * @param io_cols user selected columns; initial value gets reflected in the scale
-   * @param max_cols the upper soft limit for the number of columns
+   * @param io_rows user selected rows; initial value gets reflected in the spin button
+   * @param io_cols user selected columns; initial value gets reflected in the spin button
+   * @param io_no_guess wether the field should be solvable without guessing; initial value gets reflected in the check box
    *
    * @return the action the user selected
    */
   ReturnType run(
     Type type,
     index_t &io_rows,
-    index_t max_rows,
     index_t &io_cols,
-    index_t max_cols
+    bool &io_no_guess
   );
 
 private:
@@ -57,7 +55,8 @@ private:
 
   MW_DECLARE_LOGGER;
 
-  Gtk::HScale rows_widget, cols_widget;
+  Gtk::SpinButton rows_widget, cols_widget;
+  Gtk::CheckButton no_guess_widget;
   Gtk::Label  main_text;
   Gtk::Button *undo_button;
 };
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "defines.hpp"
+#include "gui_defines.hpp"
 #include "debug.hpp"
 
 #include <gtkmm.h>
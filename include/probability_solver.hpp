@@ -0,0 +1,249 @@
+#pragma once
+
+#include "debug.hpp"
+#include "defines.hpp"
+#include "logic.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <map>
+
+
+class ProbabilitySolver
+{
+private:
+  typedef struct
+  {
+    // board index (row * cols + col) of the revealed number
+    index_t source;
+
+    // frontier indices of its unrevealed, unflagged surrounding tiles
+    std::vector<size_t> tiles;
+
+    // number of mines among them
+    int nr_mines;
+  } constraint_t;
+
+  typedef struct
+  {
+    // number of solutions with k mines in the component
+    std::vector<double> weights;
+
+    // number of solutions with k mines that have a mine on the tile, stored as [tile * weights.size() + k];
+    // tiles are ordered by their board index
+    std::vector<double> tile_weights;
+
+    // false if the enumeration got aborted, the tiles then count as interior tiles
+    bool is_exact = true;
+  } component_result_t;
+
+  // frontier tiles and constraint values of a component, it fully determines the component result
+  typedef std::vector<index_t> component_key_t;
+
+public:
+  /**
+   * @brief Create a solver computing mine probabilities from the publicly visible state of the minefield.
+   *
+   * @note Flags are trusted, i.e. the solver assumes every flagged tile is a mine.
+   *
+   * @param minefield minefield to be solved
+   */
+  ProbabilitySolver(
+    Minefield &minefield
+  );
+
+  /**
+   * @brief Rebuild the solver state from the whole minefield, e.g. after it got reset or resized.
+   *
+   * @note The rebuild is deferred to the next query and notifications are ignored until then, so games that never
+   *       need a guess don't pay for it.
+   */
+  void sync();
+
+  /**
+   * @brief Let the solver know about revealed tiles.
+   *
+   * @param revealed_tiles tiles revealed by the last move
+   */
+  void notifyRevealed(
+    const Minefield::cascade_t &revealed_tiles
+  );
+
+  /**
+   * @brief Let the solver know a tile got hidden again.
+   *
+   * @param row row / y coordinate
+   * @param col column / x coordinate
+   */
+  void notifyRevealUndone(
+    index_t row,
+    index_t col
+  );
+
+  /**
+   * @brief Let the solver know a tile got flagged or unflagged.
+   *
+   * @param row row / y coordinate
+   * @param col column / x coordinate
+   */
+  void notifyFlagToggled(
+    index_t row,
+    index_t col
+  );
+
+  /**
+   * @brief Compute the probability of every tile being a mine.
+   *
+   * @note The frontier (unrevealed tiles next to a revealed number) is split into independent components, which
+   *       get enumerated separately and combined with the number of mines left. Components that did not change
+   *       since the last call are not enumerated again. Components taking more than
+   *       PROBABILITY_MAX_ENUMERATION_NODES steps are approximated by treating their tiles as interior tiles.
+   *
+   * @note The frontier is kept between calls, so the solver has to be synced after a reset and notified about
+   *       every move.
+   *
+   * @param o_probabilities mine probability per tile in row major order; 0 for revealed numbers, 1 for flagged
+   *                        tiles and revealed mines
+   *
+   * @returns true if the visible state is consistent, false otherwise (e.g. because of a wrong flag)
+   */
+  bool computeProbabilities(
+    std::vector<double> &o_probabilities
+  );
+
+private:
+  /**
+   * @brief Read the whole minefield.
+   */
+  void rebuild();
+
+  /**
+   * @brief Read a changed tile from the minefield and queue the revealed numbers around it as constraints.
+   *
+   * @param board_idx board index (row * cols + col) of the tile
+   */
+  void updateTile(
+    index_t board_idx
+  );
+
+  /**
+   * @brief Build the frontier tiles and the constraints on them from the queued revealed numbers.
+   *
+   * @note Revealed numbers without any unrevealed, unflagged surrounding tile are dropped from the queue, so only
+   *       the frontier gets visited and not the whole field.
+   */
+  void collectFrontier();
+
+  /**
+   * @brief Split the frontier into components of tiles that are connected through constraints.
+   *
+   * @note Also numbers the tiles and constraints within their component, see component_tile_positions.
+   *
+   * @param o_components frontier indices of the tiles per component, sorted by board index
+   * @param o_component_constraints constraint indices per component
+   */
+  void splitComponents(
+    std::vector<std::vector<size_t>> &o_components,
+    std::vector<std::vector<size_t>> &o_component_constraints
+  );
+
+  /**
+   * @brief Count the solutions of a component by backtracking over its tiles.
+   *
+   * @param tiles frontier indices of the component tiles, sorted by board index
+   * @param constraint_ids constraints of the component
+   * @param o_result solution counts per number of mines
+   *
+   * @returns true if the component has at least one solution, false otherwise
+   */
+  bool enumerateComponent(
+    const std::vector<size_t> &tiles,
+    const std::vector<size_t> &constraint_ids,
+    component_result_t &o_result
+  );
+
+  /**
+   * @brief Get the logarithms of the weights of distributing mines over the interior tiles, i.e. of binomial
+   *        coefficients.
+   *
+   * @param nr_interior_tiles number of interior tiles
+   * @param max_mines largest number of interior mines needed
+   *
+   * @returns log weight for 0 to max_mines interior mines, -infinity for more mines than interior tiles
+   */
+  std::vector<double> getInteriorLogWeights(
+    index_t nr_interior_tiles,
+    index_t max_mines
+  );
+
+  /**
+   * @brief Check if a tile is known to be a mine, i.e. flagged or a revealed mine.
+   *
+   * @param info publicly visible state of the tile
+   *
+   * @returns true if the tile is a known mine, false otherwise
+   */
+  static inline bool isKnownMine(
+    const Minefield::tile_info_t &info
+  );
+
+  /**
+   * @brief Convolve two mine count distributions given as logarithms of their weights.
+   *
+   * @param left first distribution
+   * @param right second distribution
+   *
+   * @returns log weights of the summed mine counts
+   */
+  static std::vector<double> logConvolve(
+    const std::vector<double> &left,
+    const std::vector<double> &right
+  );
+
+  /**
+   * @brief Sum weights given as logarithms without leaving the range of a double.
+   *
+   * @param log_terms logarithms of the summands
+   *
+   * @returns logarithm of the sum, -infinity if there are no summands
+   */
+  static double logSumExp(
+    const std::vector<double> &log_terms
+  );
+
+private:
+  MW_DECLARE_LOGGER;
+
+  Minefield &minefield;
+  field_size_t field_size;
+
+  // publicly visible state of the field, kept up to date by the notifications
+  bool is_synced = false;
+  std::vector<Minefield::tile_info_t> tile_infos;
+  index_t \
+    nr_untouched_tiles = 0l,
+    nr_known_mines = 0l;
+
+  // revealed numbers that might still constrain a tile, each queued at most once
+  std::vector<index_t> constraint_sources;
+  std::vector<bool> is_constraint_source;
+
+  std::vector<index_t> frontier_tiles;
+  // index into frontier_tiles per board index, or -1 for tiles not on the frontier
+  std::vector<int64_t> frontier_ids;
+  std::vector<constraint_t> constraints;
+  // constraint indices per frontier tile
+  std::vector<std::vector<size_t>> tile_constraints;
+
+  // position of each frontier tile / constraint within its component, so enumerating a component only allocates
+  // memory proportional to its own size
+  std::vector<size_t> \
+    component_tile_positions,
+    component_constraint_positions;
+
+  // component results of the last query, looked up by their key
+  std::map<component_key_t, component_result_t> component_cache;
+
+  // log(n!) for all n used so far
+  std::vector<double> log_factorials;
+};
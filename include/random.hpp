@@ -0,0 +1,106 @@
+#pragma once
+
+#include "defines.hpp"
+
+#include <cstdint>
+#include <limits>
+
+
+/**
+ * @brief Small and fast pseudo random generator (xoshiro256**) with a fully specified output.
+ *
+ * @note Unlike the standard distributions, @ref `uniform` is part of this class, so a given seed yields the same
+ *       numbers with every compiler and standard library.
+ */
+class Xoshiro256
+{
+public:
+  typedef uint64_t result_type;
+
+  /**
+   * @brief Create the generator and expand the seed into its state.
+   *
+   * @param seed seed to start from
+   */
+  explicit Xoshiro256(
+    seed_t seed
+  )
+  {
+    // splitmix64 spreads similar seeds apart and never produces the forbidden all zero state
+    for (uint64_t &word: this->state)
+    {
+      seed += 0x9e3779b97f4a7c15ull;
+
+      uint64_t mixed = seed;
+      mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ull;
+      mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebull;
+      word = mixed ^ (mixed >> 31);
+    }
+  }
+
+  static constexpr result_type min()
+  {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  static constexpr result_type max()
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * @brief Advance the generator.
+   *
+   * @returns the next 64 random bits
+   */
+  result_type operator()()
+  {
+    const uint64_t result = rotateLeft(this->state[1] * 5ull, 7) * 9ull;
+    const uint64_t shifted = this->state[1] << 17;
+
+    this->state[2] ^= this->state[0];
+    this->state[3] ^= this->state[1];
+    this->state[1] ^= this->state[2];
+    this->state[0] ^= this->state[3];
+
+    this->state[2] ^= shifted;
+    this->state[3] = rotateLeft(this->state[3], 45);
+
+    return result;
+  }
+
+  /**
+   * @brief Draw an unbiased number from [0, upper] (Lemire's multiply and reject method).
+   *
+   * @param upper largest number that may be drawn
+   *
+   * @returns the drawn number
+   */
+  uint64_t uniform(
+    uint64_t upper
+  )
+  {
+    if (upper == max()) return (*this)();
+
+    const uint64_t range = upper + 1ull;
+    unsigned __int128 product = static_cast<unsigned __int128>((*this)()) * range;
+    if (static_cast<uint64_t>(product) < range)
+    {
+      const uint64_t threshold = (0ull - range) % range;
+      while (static_cast<uint64_t>(product) < threshold)
+      {
+        product = static_cast<unsigned __int128>((*this)()) * range;
+      }
+    }
+
+    return static_cast<uint64_t>(product >> 64);
+  }
+
+private:
+  static constexpr uint64_t rotateLeft(uint64_t value, int bits)
+  {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  uint64_t state[4];
+};
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "debug.hpp"
+#include "defines.hpp"
+#include "random.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+
+class Simulator
+{
+public:
+  enum class FirstClick
+  {
+    CENTER, CORNER, EDGE, RANDOM
+  };
+
+  typedef struct
+  {
+    field_size_t field_size;
+    double mine_density = DEFAULT_BOMB_FACTOR;
+    index_t initial_patch_size = MIN_INITIAL_FIELDS;
+    FirstClick first_click = FirstClick::CENTER;
+  } config_t;
+
+  typedef struct
+  {
+    uint64_t \
+      nr_games              = 0ull,
+      nr_wins               = 0ull,
+      nr_wins_without_guess = 0ull,
+      nr_guesses            = 0ull, // including the one losing the game
+      nr_opening_tiles      = 0ull, // tiles revealed by the first click
+      min_opening_tiles     = UINT64_MAX,
+      max_opening_tiles     = 0ull;
+
+    // time spent playing the games, summed over all workers
+    double cpu_seconds = 0.;
+  } result_t;
+
+private:
+  typedef struct
+  {
+    size_t config_idx;
+    uint64_t \
+      first_game,
+      nr_games;
+  } task_t;
+
+  // owners take tasks from the back of their queue, idle workers steal from the front; each queue gets its own
+  // cache line, so locking one does not slow down the workers using the neighbouring ones
+  typedef struct alignas(CACHE_LINE_SIZE)
+  {
+    std::mutex mutex;
+    std::deque<task_t> tasks;
+  } task_queue_t;
+
+public:
+  /**
+   * @brief Create a simulator playing games with the solver, guessing the safest tile if it gets stuck.
+   *
+   * @param nr_games games to play per configuration
+   * @param base_seed seed the minefields are derived from
+   * @param nr_threads worker threads, 0 for one per core
+   */
+  Simulator(
+    uint64_t nr_games,
+    seed_t base_seed,
+    unsigned int nr_threads = 0u
+  );
+
+  /**
+   * @brief Play all games of all configurations.
+   *
+   * @note Game `i` uses the same seed in every configuration, so configurations of the same field size are
+   *       compared on the same minefields as far as the first click allows.
+   *
+   * @param configs configurations to simulate
+   * @param o_results results per configuration
+   * @param o_seconds wall clock time of the whole run
+   */
+  void run(
+    const std::vector<config_t> &configs,
+    std::vector<result_t> &o_results,
+    double &o_seconds
+  );
+
+  /**
+   * @brief Get the number of worker threads.
+   *
+   * @returns number of worker threads
+   */
+  unsigned int getNrThreads();
+
+private:
+  /**
+   * @brief Worker loop, playing tasks until there are none left in any queue.
+   *
+   * @param worker_idx index of the worker and its queue
+   * @param worker_seed seed of the minefield the worker plays on, every game still gets its own seed
+   * @param configs configurations to simulate
+   * @param o_results results per configuration of this worker
+   */
+  void work(
+    size_t worker_idx,
+    seed_t worker_seed,
+    const std::vector<config_t> &configs,
+    std::vector<result_t> &o_results
+  );
+
+  /**
+   * @brief Take a task from the own queue or, if it is empty, steal one from another worker.
+   *
+   * @param worker_idx index of the worker
+   * @param o_task the task to play
+   *
+   * @returns true if a task was found, false if all queues are empty
+   */
+  bool popTask(
+    size_t worker_idx,
+    task_t &o_task
+  );
+
+  /**
+   * @brief Play the games of a task.
+   *
+   * @param config configuration of the task
+   * @param task games to play
+   * @param worker_seed seed of the worker playing the task
+   * @param io_result result the games get added to
+   */
+  void playGames(
+    const config_t &config,
+    const task_t &task,
+    seed_t worker_seed,
+    result_t &io_result
+  );
+
+  /**
+   * @brief Choose the first tile to reveal.
+   *
+   * @param config configuration of the game
+   * @param random_generator generator of the game, used for random first clicks
+   * @param o_row row / y coordinate
+   * @param o_col column / x coordinate
+   */
+  static void getFirstClick(
+    const config_t &config,
+    Xoshiro256 &random_generator,
+    index_t &o_row,
+    index_t &o_col
+  );
+
+private:
+  MW_DECLARE_LOGGER;
+
+  uint64_t nr_games;
+  seed_t base_seed;
+  unsigned int nr_threads;
+
+  std::vector<task_queue_t> task_queues;
+};
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "debug.hpp"
+#include "defines.hpp"
+#include "logic.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <array>
+
+
+class Solver
+{
+public:
+  typedef struct
+  {
+    index_t row, col;
+  } tile_position_t;
+
+private:
+  //! NOTE: one per tile, so it is kept small and the surrounding tiles are only stored as a mask
+  typedef struct
+  {
+    // bit i is set if the surrounding tile in direction i (see neighbor_offsets) is unrevealed and unflagged
+    uint8_t unknown_mask = 0u;
+
+    // number of mines among them
+    int8_t nr_mines = 0;
+  } constraint_t;
+
+  enum class Deduction : uint8_t
+  {
+    UNKNOWN, SAFE, MINE
+  };
+
+public:
+  /**
+   * @brief Create a solver working on the publicly visible state of the minefield.
+   *
+   * @note Flags are trusted, i.e. the solver assumes every flagged tile is a mine.
+   *
+   * @param minefield minefield to be solved
+   */
+  Solver(
+    Minefield &minefield
+  );
+
+  /**
+   * @brief Rebuild the solver state from the whole minefield, e.g. after it got reset or resized.
+   */
+  void sync();
+
+  /**
+   * @brief Let the solver know about revealed tiles.
+   *
+   * @param revealed_tiles tiles revealed by the last move
+   */
+  void notifyRevealed(
+    const Minefield::cascade_t &revealed_tiles
+  );
+
+  /**
+   * @brief Let the solver know a tile got hidden again.
+   *
+   * @param row row / y coordinate
+   * @param col column / x coordinate
+   */
+  void notifyRevealUndone(
+    index_t row,
+    index_t col
+  );
+
+  /**
+   * @brief Let the solver know a tile got flagged or unflagged.
+   *
+   * @param row row / y coordinate
+   * @param col column / x coordinate
+   */
+  void notifyFlagToggled(
+    index_t row,
+    index_t col
+  );
+
+  /**
+   * @brief Deduce which unrevealed tiles are certainly safe and which are certainly mines.
+   *
+   * @note Only the constraints touched since the last call get reevaluated. Deductions that have not been acted
+   *       upon yet are reported again.
+   *
+   * @param o_safe_tiles tiles that can be revealed without risk
+   * @param o_mines tiles that certainly are mines
+   *
+   * @returns true if anything could be deduced, false otherwise
+   */
+  bool findMoves(
+    std::vector<tile_position_t> &o_safe_tiles,
+    std::vector<tile_position_t> &o_mines
+  );
+
+  /**
+   * @brief Reveal safe tiles and flag mines on the minefield until nothing can be deduced anymore.
+   *
+   * @returns true if all non-mine tiles got revealed, false if guessing would be required
+   */
+  bool solve();
+
+  /**
+   * @brief Reveal safe tiles and flag mines on the minefield until nothing can be deduced anymore.
+   *
+   * @param o_revealed_tiles all tiles revealed along the way, e.g. to notify other solvers
+   * @param o_flagged_tiles all tiles flagged along the way
+   *
+   * @returns true if all non-mine tiles got revealed, false if guessing would be required
+   */
+  bool solve(
+    Minefield::cascade_t &o_revealed_tiles,
+    std::vector<tile_position_t> &o_flagged_tiles
+  );
+
+private:
+  /**
+   * @brief Queue the constraints of a tile and its surrounding tiles for reevaluation.
+   *
+   * @param board_idx board index (row * cols + col) of the tile
+   */
+  void markDirty(
+    index_t board_idx
+  );
+
+  /**
+   * @brief Read the constraint of a tile from the minefield.
+   *
+   * @param board_idx board index of the tile
+   */
+  void updateConstraint(
+    index_t board_idx
+  );
+
+  /**
+   * @brief Apply the single point rules: no mines left means all tiles are safe, as many mines as tiles means
+   *        all tiles are mines.
+   *
+   * @param board_idx board index of the constraint source
+   */
+  void applySinglePointRules(
+    index_t board_idx
+  );
+
+  /**
+   * @brief Compare all constraints changed since the last call to their surrounding constraints.
+   */
+  void applySubsetRulesToDirty();
+
+  /**
+   * @brief Apply the subset rules (e.g. 1-1 and 1-2 patterns) to two overlapping constraints.
+   *
+   * @param first_idx board index of the constraint whose exclusive tiles may be deduced safe
+   * @param second_idx board index of the constraint whose exclusive tiles may be deduced safe or mines
+   */
+  void applySubsetRules(
+    index_t first_idx,
+    index_t second_idx
+  );
+
+  /**
+   * @brief Record a deduction for a tile, ignoring tiles that have already been deduced.
+   *
+   * @param board_idx board index of the tile
+   * @param deduction what is known about the tile
+   */
+  inline void deduce(
+    index_t board_idx,
+    Deduction deduction
+  );
+
+  /**
+   * @brief Record a deduction for all tiles of an area.
+   *
+   * @param center_idx board index of the tile in the center of the area
+   * @param area 7x7 area around the center tile, see @ref `getConstraintArea`
+   * @param deduction what is known about the tiles
+   */
+  inline void deduceArea(
+    index_t center_idx,
+    uint64_t area,
+    Deduction deduction
+  );
+
+  /**
+   * @brief Lay the unknown tiles of a constraint out on a 7x7 area, one bit per tile in row major order.
+   *
+   * @param board_idx board index of the constraint source
+   * @param row_offset row of the source relative to the center of the area, between -2 and 2
+   * @param col_offset column of the source relative to the center of the area, between -2 and 2
+   *
+   * @returns the area bit mask
+   */
+  inline uint64_t getConstraintArea(
+    index_t board_idx,
+    index_t row_offset,
+    index_t col_offset
+  );
+
+  /**
+   * @brief Get the board indices of the unknown tiles of a constraint.
+   *
+   * @param board_idx board index of the constraint source
+   * @param o_tiles board indices of the unknown tiles
+   *
+   * @returns number of unknown tiles
+   */
+  inline uint8_t getConstraintTiles(
+    index_t board_idx,
+    std::array<index_t, 8ul> &o_tiles
+  );
+
+  /**
+   * @brief Check if the given position is inside the field boundaries.
+   *
+   * @param row row / y coordinate
+   * @param col column / x coordinate
+   *
+   * @return true if row/col are in bounds, false otherwise
+   */
+  inline bool checkTilePositionValid(
+    index_t row,
+    index_t col
+  );
+
+  /**
+   * @brief Get the publicly visible state of a tile.
+   *
+   * @param board_idx board index of the tile
+   *
+   * @returns the state of the tile
+   */
+  inline Minefield::TileState getTileState(
+    index_t board_idx
+  );
+
+private:
+  MW_DECLARE_LOGGER;
+
+  Minefield &minefield;
+  field_size_t field_size;
+
+  std::vector<constraint_t> constraints;
+
+  // work queue of tiles whose constraint has to be reevaluated, each queued at most once
+  std::vector<index_t> dirty_tiles;
+  std::vector<bool> is_dirty;
+
+  // same for the subset rules, which are only applied once the single point rules got stuck
+  std::vector<index_t> subset_dirty_tiles;
+  std::vector<bool> is_subset_dirty;
+
+  // deductions persist until the tile gets flagged or unflagged, pending ones still wait to be acted upon
+  std::vector<Deduction> deductions;
+  std::vector<index_t> \
+    pending_safe_tiles,
+    pending_mines;
+
+  static const std::array<tile_position_t, 8ul> neighbor_offsets;
+};
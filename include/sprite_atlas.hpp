@@ -0,0 +1,79 @@
+#pragma once
+
+#include "gui_defines.hpp"
+#include "debug.hpp"
+
+#include <gtkmm.h>
+
+#include <list>
+#include <vector>
+
+
+class SpriteAtlas
+{
+private:
+  typedef struct
+  {
+    int tile_size, scale_factor;
+    Cairo::RefPtr<Cairo::ImageSurface> surface;
+  } atlas_t;
+
+public:
+  /**
+   * @brief Create an empty atlas cache.
+   *
+   * @param capacity number of atlases (i.e. zoom levels) kept before the least recently used one gets dropped
+   */
+  SpriteAtlas(
+    size_t capacity = SPRITE_ATLAS_CACHE_SIZE
+  );
+
+  /**
+   * @brief Set the sprites contained in every atlas and drop all cached ones.
+   *
+   * @param sprites the sprites in the order they are placed in the atlas
+   */
+  void setSprites(
+    const std::vector<sprite_t> &sprites
+  );
+
+  /**
+   * @brief Get the atlas for a tile size, creating it if it is not cached.
+   *
+   * @note The sprites are placed next to each other, sprite i starts at x = i * tile_size. The surface has
+   *       tile_size * scale_factor device pixels per sprite and its device scale set accordingly, so it can be
+   *       drawn in logical coordinates on high dpi screens without any further scaling.
+   *
+   * @param tile_size size of a sprite in logical pixels
+   * @param scale_factor device pixels per logical pixel
+   *
+   * @returns the atlas surface
+   */
+  Cairo::RefPtr<Cairo::ImageSurface> getAtlas(
+    int tile_size,
+    int scale_factor
+  );
+
+private:
+  /**
+   * @brief Scale all sprites once and paint them into a new atlas.
+   *
+   * @param tile_size size of a sprite in logical pixels
+   * @param scale_factor device pixels per logical pixel
+   *
+   * @returns the atlas surface
+   */
+  Cairo::RefPtr<Cairo::ImageSurface> createAtlas(
+    int tile_size,
+    int scale_factor
+  );
+
+private:
+  MW_DECLARE_LOGGER;
+
+  std::vector<sprite_t> sprites;
+
+  // cached atlases, the most recently used one first
+  std::list<atlas_t> atlases;
+  size_t capacity;
+};
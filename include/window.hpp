@@ -1,7 +1,7 @@
 #pragma once
 
-#include "defines.hpp"
-#include "tile.hpp"
+#include "gui_defines.hpp"
+#include "board_widget.hpp"
 #include "debug.hpp"
 
 #include <gtkmm.h>
@@ -18,14 +18,20 @@ public:
     void
   > restart_button_callback_t;
 
+  typedef sigc::slot<
+    void,
+    bool /*is_active*/,
+    index_t /*moves_per_second*/
+  > auto_play_button_callback_t;
+
 public:
   /**
    * @brief Create a window displaying the minefield.
    *
-   * @param tile_clicked_callback the callback to relay to all tiles
+   * @param tile_clicked_callback the callback to relay tile clicks to
    */
   Window(
-    Tile::callback_t tile_clicked_callback
+    BoardWidget::callback_t tile_clicked_callback
   );
 
   /**
@@ -37,6 +43,26 @@ public:
     const restart_button_callback_t &callback
   );
 
+  /**
+   * @brief (Re)bind a callback to the auto play button and the move rate next to it.
+   *
+   * @note The auto play button is inactive until a callback is bound.
+   *
+   * @param callback the new callback, called whenever the button gets toggled or the move rate changes
+   */
+  void bindAutoPlayButtonCallback(
+    const auto_play_button_callback_t &callback
+  );
+
+  /**
+   * @brief Toggle the auto play button, e.g. when auto play stopped by itself.
+   *
+   * @param is_active wether the button is pressed
+   */
+  void setAutoPlayActive(
+    bool is_active
+  );
+
 # ifdef MW_DEBUG
   void setTileDebugCallback(
     const sigc::slot<std::string, index_t, index_t> &callback
@@ -44,27 +70,21 @@ public:
 # endif //!defined(MW_DEBUG)
 
   /**
-   * @brief Reveal a tile as a number (1-8), empty (0) or bomb (-1).
+   * @brief Reveal all tiles of a cascade at once, so they get drawn in a single frame.
    *
-   * @param row row / y coordinate
-   * @param col column / x coordinate
-   * @param as type of field
+   * @param cascade the revealed tiles
    */
-  void revealField(
-    index_t row,
-    index_t col,
-    int as
+  void applyCascade(
+    const Minefield::cascade_t &cascade
   );
 
   /**
-   * @brief Undo revelation of tile.
+   * @brief Undo the revelation of all tiles of a cascade at once.
    *
-   * @param row row / y coordinate
-   * @param col column / x coordinate
+   * @param cascade the tiles to hide again
    */
-  void undoFieldReveal(
-    index_t row,
-    index_t col
+  void undoCascade(
+    const Minefield::cascade_t &cascade
   );
 
   /**
@@ -97,11 +117,6 @@ public:
    */
   void resetMinefield();
 
-  /**
-   * @brief Check the soft maximum rows and columns for the current window size.
-   */
-  field_size_t getMaxFieldSize();
-
 private:
   /**
    * @brief Update the mine counter label/display.
@@ -115,18 +130,6 @@ private:
    */
   bool loadSprites();
 
-  /**
-   * @brief Get the @ref Tile from the field grid widgets children.
-   *
-   * @note Does not check if the pointer is valid.
-   *
-   * @param row row / y coordinate
-   * @param col column / x coordinate
-   *
-   * @return a pointer to the tile
-   */
-  inline Tile *getTile(index_t row, index_t col);
-
 private:
   MW_DECLARE_LOGGER;
 
@@ -138,14 +141,14 @@ private:
   std::array<Glib::RefPtr<Gdk::Pixbuf>, 10ul> reveal_sprites;
   state_sprites_t untouched_sprites, flagged_sprites;
 
-  Gtk::Grid field_widget;
+  BoardWidget field_widget;
   Gtk::Label nr_bombs_widget;
   Gtk::Button restart_widget;
+  Gtk::ToggleButton auto_play_widget;
+  Gtk::SpinButton auto_play_rate_widget;
 
-  Tile::callback_t shared_tile_clicked_callback;
   sigc::connection restart_button_callback_connection;
-
-# ifdef MW_DEBUG
-  sigc::slot<std::string, index_t, index_t> tile_information_callback;
-# endif //!defined(MW_DEBUG)
+  sigc::connection \
+    auto_play_button_callback_connection,
+    auto_play_rate_callback_connection;
 };
\ No newline at end of file
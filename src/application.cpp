@@ -5,6 +5,7 @@
 #include <thread>
 #include <chrono>
 #include <iomanip>
+#include <algorithm>
 
 
 Application::Application():
@@ -12,6 +13,8 @@ Application::Application():
 {
   MW_SET_CLASS_ORIGIN;
   MW_SET_FUNC_SCOPE;
+
+  this->mines_placed_dispatcher.connect(sigc::mem_fun(*this, &Application::minesPlacedCallback));
 }
 
 
@@ -44,11 +47,7 @@ NewGameDialog::ReturnType Application::showNewGame(NewGameDialog::Type type, ind
 {
   MW_SET_FUNC_SCOPE;
 
-  field_size_t theoretical_max = this->window->getMaxFieldSize();
-  NewGameDialog::ReturnType dialog_response = this->new_game_dialog->run(type,
-    o_rows, theoretical_max.rows,
-    o_cols, theoretical_max.cols
-  );
+  NewGameDialog::ReturnType dialog_response = this->new_game_dialog->run(type, o_rows, o_cols, this->no_guess);
   this->new_game_dialog->hide();
 
   return dialog_response;
@@ -69,6 +68,12 @@ void Application::clickedCallback(bool is_reveal, index_t row, index_t col)
 {
   MW_SET_FUNC_SCOPE;
 
+  // the first reveal is still waiting for its minefield
+  if (this->mine_placer.joinable()) return;
+
+  // the user takes over
+  this->stopAutoPlay();
+
   if (is_reveal)
   {
     this->revealCallback(row, col);
@@ -83,38 +88,78 @@ void Application::revealCallback(index_t row, index_t col)
 {
   MW_SET_FUNC_SCOPE;
 
+  if (this->no_guess && !this->minefield->checkFieldInitialized())
+  {
+    this->startPlacingMines(row, col);
+
+    return;
+  }
+
   std::vector<Minefield::tile_with_position_t> cascade;
   bool has_hit_mine;
   if (!this->minefield->revealTile(row, col, cascade, has_hit_mine)) return;
 
   if (has_hit_mine)
   {
-    for (const Minefield::tile_with_position_t &tile : cascade)
-    {
-      this->window->revealField(tile.row, tile.col, tile.type);
-      if (tile.type == -1) break;
-    }
+    // only show the tiles up to the mine
+    auto shown_end_it = std::find_if(cascade.begin(), cascade.end(), [](const Minefield::tile_with_position_t &tile) { return tile.type == -1; });
+    if (shown_end_it != cascade.end()) shown_end_it++;
+    this->window->applyCascade(Minefield::cascade_t(cascade.begin(), shown_end_it));
 
-    if (this->newGame(NewGameDialog::Type::LOSE))
-    {
-      for (const Minefield::tile_with_position_t &tile : cascade)
-      {
-        this->minefield->undoTileReveal(tile.row, tile.col);
-        this->window->undoFieldReveal(tile.row, tile.col);
-      }
-    }
+    this->loseGame(cascade);
   }
   else
   {
-    for (const Minefield::tile_with_position_t &tile : cascade)
-    {
-      this->window->revealField(tile.row, tile.col, tile.type);
-    }
+    this->window->applyCascade(cascade);
 
     this->checkGameStatus();
   }
 }
 
+void Application::startPlacingMines(index_t row, index_t col)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(debug) << "placing mines for first reveal @ row=" << row << " col=" << col;
+
+  this->first_reveal_row = row;
+  this->first_reveal_col = col;
+  this->mine_placer = std::jthread(
+    [this, row, col](std::stop_token stop_token)
+    {
+      if (!this->minefield->placeMines(row, col, stop_token)) return;
+
+      this->has_placed_mines = true;
+      this->mines_placed_dispatcher.emit();
+    }
+  );
+}
+
+void Application::minesPlacedCallback()
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (!this->has_placed_mines) return;
+
+  this->mine_placer.join();
+  this->has_placed_mines = false;
+
+  this->revealCallback(this->first_reveal_row, this->first_reveal_col);
+}
+
+void Application::stopPlacingMines()
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (!this->mine_placer.joinable()) return;
+
+  MW_LOG(debug) << "cancelling placement of mines";
+
+  this->mine_placer.request_stop();
+  this->mine_placer.join();
+  this->has_placed_mines = false;
+}
+
 void Application::flagCallback(index_t row, index_t col)
 {
   MW_SET_FUNC_SCOPE;
@@ -127,6 +172,83 @@ void Application::flagCallback(index_t row, index_t col)
   this->checkGameStatus();
 }
 
+# ifdef MW_DEBUG
+std::string Application::tileDebugCallback(index_t row, index_t col)
+{
+  // the first reveal is still waiting for its minefield
+  if (this->mine_placer.joinable()) return "placing mines";
+
+  return this->minefield->getTileString(row, col);
+}
+# endif //defined(MW_DEBUG)
+
+/* #endregion */
+/* #region Auto Play Callbacks */
+
+void Application::autoPlayCallback(bool is_active, index_t moves_per_second)
+{
+  MW_SET_FUNC_SCOPE;
+
+  this->auto_player->setMoveRate(moves_per_second);
+
+  if (is_active)
+  {
+    // the auto player takes over the first reveal
+    this->stopPlacingMines();
+    this->auto_player->start();
+  }
+  else
+  {
+    this->auto_player->stop();
+  }
+}
+
+void Application::autoPlayMovesCallback(const std::vector<AutoPlayer::move_t> &moves)
+{
+  MW_SET_FUNC_SCOPE;
+
+  Minefield::cascade_t revealed_tiles;
+  revealed_tiles.reserve(moves.size());
+  for (const AutoPlayer::move_t &move: moves)
+  {
+    if (move.is_flag)
+    {
+      this->window->setFieldFlag(move.row, move.col, true);
+    }
+    else
+    {
+      revealed_tiles.push_back(Minefield::tile_with_position_t{move.row, move.col, move.type});
+    }
+  }
+  this->window->applyCascade(revealed_tiles);
+}
+
+void Application::autoPlayFinishedCallback(bool has_hit_mine)
+{
+  MW_SET_FUNC_SCOPE;
+
+  this->window->setAutoPlayActive(false);
+
+  if (has_hit_mine)
+  {
+    this->loseGame(this->auto_player->getLastCascade());
+  }
+  else
+  {
+    this->checkGameStatus();
+  }
+}
+
+void Application::stopAutoPlay()
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (!this->auto_player) return;
+
+  this->auto_player->stop();
+  this->window->setAutoPlayActive(false);
+}
+
 /* #endregion */
 /* #region Game Control */
 
@@ -142,8 +264,18 @@ void Application::startGame()
   }
 
   this->minefield = std::make_unique<Minefield>(current_field_size.rows, current_field_size.cols);
+  this->minefield->setGenerationMode(this->no_guess ? Minefield::GenerationMode::NO_GUESS : Minefield::GenerationMode::RANDOM);
   this->window->generateMinefield(current_field_size.rows, current_field_size.cols, this->minefield->getNrMines());
 
+  this->auto_player = std::make_unique<AutoPlayer>(
+    *(this->minefield),
+    sigc::mem_fun1(*this, &Application::autoPlayMovesCallback),
+    sigc::mem_fun1(*this, &Application::autoPlayFinishedCallback)
+  );
+  this->window->bindAutoPlayButtonCallback(
+    sigc::mem_fun2(*this, &Application::autoPlayCallback)
+  );
+
   this->window->bindRestartButtonCallback(
     [&]() -> void
     {
@@ -153,7 +285,7 @@ void Application::startGame()
 
 # ifdef MW_DEBUG
   this->window->setTileDebugCallback(
-    sigc::mem_fun2(*(this->minefield), &Minefield::getTileString)
+    sigc::mem_fun2(*this, &Application::tileDebugCallback)
   );
 # endif //defined(DEBUG)
 }
@@ -162,6 +294,9 @@ bool Application::newGame(NewGameDialog::Type type)
 {
   MW_SET_FUNC_SCOPE;
 
+  this->stopAutoPlay();
+  this->stopPlacingMines();
+
   index_t  rows = this->current_field_size.rows,
           cols = this->current_field_size.cols;
   NewGameDialog::ReturnType new_game_return_type = this->showNewGame(type, rows, cols);
@@ -177,6 +312,8 @@ bool Application::newGame(NewGameDialog::Type type)
     return false;
   }
 
+  this->minefield->setGenerationMode(this->no_guess ? Minefield::GenerationMode::NO_GUESS : Minefield::GenerationMode::RANDOM);
+
   MW_LOG(debug) << "current: rows=" << this->current_field_size.rows << " cols=" << this->current_field_size.cols;
   MW_LOG(debug) << "new:     rows=" << rows                          << " cols=" << cols;
   if (this->current_field_size.rows == rows && this->current_field_size.cols == cols)
@@ -195,6 +332,20 @@ bool Application::newGame(NewGameDialog::Type type)
   return false;
 }
 
+void Application::loseGame(const Minefield::cascade_t &cascade)
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (this->newGame(NewGameDialog::Type::LOSE))
+  {
+    for (const Minefield::tile_with_position_t &tile : cascade)
+    {
+      this->minefield->undoTileReveal(tile.row, tile.col);
+    }
+    this->window->undoCascade(cascade);
+  }
+}
+
 void Application::checkGameStatus()
 {
   if (this->minefield->checkGameWon())
@@ -209,8 +360,10 @@ void Application::checkGameStatus()
     {
       Minefield::cascade_t cascade;
       this->minefield->revealTilesForUser(cascade);
+      this->window->applyCascade(cascade);
 
-      for (const Minefield::tile_with_position_t &tile: cascade);
+      // the revealed tiles may have finished the game
+      this->checkGameStatus();
     }
     else if (response == NoMovesLeftDialog::ReturnType::RESTART)
     {
@@ -0,0 +1,270 @@
+#include "auto_player.hpp"
+#include "solver.hpp"
+
+#include <algorithm>
+
+
+AutoPlayer::AutoPlayer(Minefield &minefield, moves_callback_t moves_callback, finished_callback_t finished_callback):
+  minefield(minefield),
+  moves_callback(moves_callback),
+  finished_callback(finished_callback)
+{
+  MW_SET_CLASS_ORIGIN;
+  MW_SET_FUNC_SCOPE;
+
+  this->dispatcher.connect(sigc::mem_fun(*this, &AutoPlayer::dispatchMoves));
+}
+
+
+/* #region control */
+
+void AutoPlayer::start()
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (this->isRunning()) return;
+
+  MW_LOG(debug) << "starting with " << this->moves_per_second.load() << " moves per second";
+
+  {
+    std::lock_guard<std::mutex> lock(this->moves_mutex);
+    this->pending_moves.clear();
+    this->has_finished = false;
+    this->has_hit_mine = false;
+  }
+
+  this->worker = std::jthread(
+    [this](std::stop_token stop_token)
+    {
+      this->play(stop_token);
+    }
+  );
+}
+
+void AutoPlayer::stop()
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (!this->isRunning()) return;
+
+  this->worker.request_stop();
+  this->worker.join();
+
+  {
+    std::lock_guard<std::mutex> lock(this->moves_mutex);
+    this->displayed_moves.swap(this->pending_moves);
+    this->has_finished = false;
+  }
+
+  MW_LOG(debug) << "stopped with " << this->displayed_moves.size() << " moves left to display";
+
+  if (!this->displayed_moves.empty()) this->moves_callback(this->displayed_moves);
+  this->displayed_moves.clear();
+}
+
+bool AutoPlayer::isRunning()
+{
+  // the worker only gets joined by stop or once the main loop took notice of it having finished
+  return this->worker.joinable();
+}
+
+void AutoPlayer::setMoveRate(index_t moves_per_second)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "set move rate to " << moves_per_second << " moves per second";
+
+  this->moves_per_second = std::max(moves_per_second, 0l);
+}
+
+const Minefield::cascade_t &AutoPlayer::getLastCascade()
+{
+  return this->last_cascade;
+}
+
+/* #endregion */
+/* #region worker */
+
+void AutoPlayer::play(std::stop_token stop_token)
+{
+  MW_SET_FUNC_SCOPE;
+
+  std::vector<Solver::tile_position_t> safe_tiles, mines;
+  std::vector<move_t> moves;
+  Minefield::tile_info_t info;
+  bool \
+    has_revealed_mine = false,
+    is_flagged;
+
+  index_t \
+    batch_size,
+    nr_batch_moves = 0l;
+  std::chrono::steady_clock::duration interval;
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+  this->getPace(batch_size, interval);
+
+  const auto reveal = [&](index_t row, index_t col)
+  {
+    this->minefield.revealTile(row, col, this->last_cascade, has_revealed_mine);
+    for (const Minefield::tile_with_position_t &tile: this->last_cascade)
+    {
+      moves.push_back(move_t{tile.row, tile.col, tile.type, false});
+    }
+  };
+
+  bool is_stopped = false;
+
+  // nothing is placed before the first reveal, so the game gets opened up in the middle of the field
+  if (!this->minefield.checkFieldInitialized())
+  {
+    const field_size_t &field_size = this->minefield.getFieldSize();
+    // the no guess search can take a while, so it has to be cancellable as well
+    is_stopped = !this->minefield.placeMines(field_size.rows / 2l, field_size.cols / 2l, stop_token);
+    if (!is_stopped)
+    {
+      reveal(field_size.rows / 2l, field_size.cols / 2l);
+      nr_batch_moves++;
+    }
+  }
+
+  Solver solver(this->minefield);
+  while (!is_stopped && !has_revealed_mine && solver.findMoves(safe_tiles, mines))
+  {
+    for (const Solver::tile_position_t &tile: safe_tiles)
+    {
+      // an earlier cascade might have revealed it already
+      this->minefield.getTileInfo(tile.row, tile.col, info);
+      if (info.state != Minefield::TileState::UNTOUCHED) continue;
+
+      reveal(tile.row, tile.col);
+      if (has_revealed_mine) break;
+      solver.notifyRevealed(this->last_cascade);
+
+      // cascades count as a single move, but every tile of them has to be displayed
+      if (++nr_batch_moves < batch_size && moves.size() < AUTO_PLAY_MAX_PENDING_TILES) continue;
+      nr_batch_moves = 0l;
+      if ((is_stopped = !this->postMoves(moves, deadline, stop_token))) break;
+      this->getPace(batch_size, interval);
+    }
+
+    for (const Solver::tile_position_t &tile: mines)
+    {
+      if (is_stopped || has_revealed_mine) break;
+
+      this->minefield.getTileInfo(tile.row, tile.col, info);
+      if (info.state != Minefield::TileState::UNTOUCHED) continue;
+
+      this->minefield.toggleTileFlag(tile.row, tile.col, is_flagged);
+      solver.notifyFlagToggled(tile.row, tile.col);
+      moves.push_back(move_t{tile.row, tile.col, 0, true});
+
+      if (++nr_batch_moves < batch_size && moves.size() < AUTO_PLAY_MAX_PENDING_TILES) continue;
+      nr_batch_moves = 0l;
+      is_stopped = !this->postMoves(moves, deadline, stop_token);
+      this->getPace(batch_size, interval);
+    }
+  }
+
+  if (has_revealed_mine)
+  {
+    // only possible if a flag set by the user was wrong
+    MW_LOG(warning) << "revealed a mine";
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->moves_mutex);
+    this->pending_moves.insert(this->pending_moves.end(), moves.begin(), moves.end());
+    this->has_finished = !is_stopped && !stop_token.stop_requested();
+    this->has_hit_mine = has_revealed_mine;
+  }
+  this->dispatcher.emit();
+
+  MW_LOG(debug) << (is_stopped ? "stopped" : "finished");
+}
+
+bool AutoPlayer::postMoves(std::vector<move_t> &io_moves, std::chrono::steady_clock::time_point &io_deadline, std::stop_token stop_token)
+{
+  {
+    std::unique_lock<std::mutex> lock(this->moves_mutex);
+
+    // hold off while the main loop is behind, so it never has to display more than a bounded number of tiles at once
+    this->moves_consumed.wait(
+      lock, stop_token,
+      [this]() { return this->pending_moves.size() < AUTO_PLAY_MAX_PENDING_TILES; }
+    );
+
+    //! NOTE: also done when stopped, so stop can hand them over to be displayed
+    this->pending_moves.insert(this->pending_moves.end(), io_moves.begin(), io_moves.end());
+    io_moves.clear();
+
+    if (stop_token.stop_requested()) return false;
+  }
+  this->dispatcher.emit();
+
+  index_t batch_size;
+  std::chrono::steady_clock::duration interval;
+  this->getPace(batch_size, interval);
+
+  // don't try to catch up on batches missed while waiting for the main loop
+  io_deadline = std::max(io_deadline + interval, std::chrono::steady_clock::now());
+
+  // sleep until the next batch is due, waking up early if stopped
+  std::unique_lock<std::mutex> lock(this->moves_mutex);
+  this->moves_consumed.wait_until(lock, stop_token, io_deadline, []() { return false; });
+
+  return !stop_token.stop_requested();
+}
+
+void AutoPlayer::getPace(index_t &o_batch_size, std::chrono::steady_clock::duration &o_interval)
+{
+  const index_t moves_per_second = this->moves_per_second.load();
+
+  if (moves_per_second == 0l)
+  {
+    // as fast as the main loop keeps up
+    o_batch_size = AUTO_PLAY_MAX_PENDING_TILES;
+    o_interval = std::chrono::steady_clock::duration::zero();
+  }
+  else if (moves_per_second <= AUTO_PLAY_BATCHES_PER_SECOND)
+  {
+    o_batch_size = 1l;
+    o_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)) / moves_per_second;
+  }
+  else
+  {
+    o_batch_size = moves_per_second / AUTO_PLAY_BATCHES_PER_SECOND;
+    o_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)) / AUTO_PLAY_BATCHES_PER_SECOND;
+  }
+}
+
+/* #endregion */
+/* #region main loop */
+
+void AutoPlayer::dispatchMoves()
+{
+  MW_SET_FUNC_SCOPE;
+
+  bool \
+    has_finished,
+    has_hit_mine;
+  {
+    std::lock_guard<std::mutex> lock(this->moves_mutex);
+    this->displayed_moves.swap(this->pending_moves);
+    has_finished = this->has_finished;
+    has_hit_mine = this->has_hit_mine;
+    this->has_finished = false;
+  }
+  this->moves_consumed.notify_all();
+
+  if (!this->displayed_moves.empty()) this->moves_callback(this->displayed_moves);
+  this->displayed_moves.clear();
+
+  if (!has_finished) return;
+
+  MW_LOG(debug) << "worker finished" << (has_hit_mine ? " by hitting a mine" : "");
+
+  this->worker.join();
+  this->finished_callback(has_hit_mine);
+}
+
+/* #endregion */
@@ -0,0 +1,551 @@
+#include "logic.hpp"
+
+#include "debug.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <string_view>
+#include <sysexits.h>
+#include <vector>
+
+
+/* #region allocation counting */
+
+//! NOTE: counts every allocation of the process, so only the timed sections get attributed to a benchmark
+static std::atomic<uint64_t> nr_allocations = 0ull;
+
+void *operator new(std::size_t size)
+{
+  nr_allocations.fetch_add(1ull, std::memory_order_relaxed);
+
+  if (void *pointer = std::malloc(size == 0ul ? 1ul : size)) return pointer;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+  nr_allocations.fetch_add(1ull, std::memory_order_relaxed);
+
+  // aligned_alloc needs the size to be a multiple of the alignment
+  const std::size_t align = static_cast<std::size_t>(alignment);
+  if (void *pointer = std::aligned_alloc(align, (size + align - 1ul) / align * align)) return pointer;
+  throw std::bad_alloc();
+}
+
+/**
+ * NOTE: All the replaced operators new allocate with malloc / aligned_alloc, so freeing in the matching operators
+ *       delete is correct. GCC can't see that pairing once they get inlined and warns about a mismatch anyway.
+ */
+# if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+# endif // defined(__GNUC__) && !defined(__clang__)
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+# if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+# endif // defined(__GNUC__) && !defined(__clang__)
+
+/* #endregion */
+/* #region benchmark helpers */
+
+// fixed seeds, so every run measures the same minefields
+#define BENCH_SEED 0x6d796e65ull
+
+// measured time after which no further rounds get started
+#define BENCH_MIN_SECONDS .2
+
+// time including the untimed setup after which no further rounds get started
+#define BENCH_MAX_SECONDS 2.
+
+#define BENCH_MAX_OPS_PER_ROUND 10000ul
+#define BENCH_CHECK_OPS_PER_ROUND 100000ul
+
+typedef struct
+{
+  std::string_view name;
+  field_size_t field_size;
+
+  uint64_t \
+    nr_ops         = 0ull,
+    nr_tiles       = 0ull, // tiles initialized or revealed, 0 if meaningless for the benchmark
+    nr_allocations = 0ull;
+  double seconds = 0.;
+} bench_result_t;
+
+/**
+ * @brief Time a section and attribute its allocations to the benchmark.
+ *
+ * @param io_result result to add the time and allocations to
+ * @param section callable to time
+ */
+template<typename section_t>
+void measure(bench_result_t &io_result, section_t &&section)
+{
+  const uint64_t nr_allocations_before = nr_allocations.load(std::memory_order_relaxed);
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  section();
+
+  io_result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  io_result.nr_allocations += nr_allocations.load(std::memory_order_relaxed) - nr_allocations_before;
+}
+
+/**
+ * @brief Run rounds of a benchmark on fresh minefields until enough time has been measured.
+ *
+ * @param name name of the benchmark
+ * @param field_size size of the minefields
+ * @param round callable setting up a minefield from a seed and measuring on it
+ *
+ * @returns the accumulated result
+ */
+template<typename round_t>
+bench_result_t runBenchmark(std::string_view name, const field_size_t &field_size, round_t &&round)
+{
+  bench_result_t result{name, field_size};
+  Minefield minefield(field_size.rows, field_size.cols);
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (seed_t round_idx = 0ull; ; round_idx++)
+  {
+    round(minefield, BENCH_SEED + round_idx, result);
+
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (result.seconds >= BENCH_MIN_SECONDS || wall_seconds >= BENCH_MAX_SECONDS) break;
+  }
+
+  std::cerr << std::setw(24) << name << std::setw(7) << field_size.rows << 'x' << std::left << std::setw(7) << field_size.cols << std::right;
+  if (result.nr_ops > 0ull)
+  {
+    std::cerr << std::setw(12) << std::fixed << std::setprecision(1) << 1e9 * result.seconds / static_cast<double>(result.nr_ops) << " ns/op\n";
+  }
+  else
+  {
+    std::cerr << std::setw(12) << "-" << " ns/op\n";
+  }
+
+  return result;
+}
+
+/**
+ * @brief Reset the minefield and reveal its center, which places the mines.
+ *
+ * @param minefield minefield to set up
+ * @param seed seed of the round
+ */
+void setupMinefield(Minefield &minefield, seed_t seed)
+{
+  const field_size_t &field_size = minefield.getFieldSize();
+  Minefield::cascade_t revealed_tiles;
+  bool has_revealed_mine;
+
+  minefield.reset(seed);
+  minefield.revealTile(field_size.rows / 2l, field_size.cols / 2l, revealed_tiles, has_revealed_mine);
+}
+
+/**
+ * @brief Find out the type of every tile by revealing all of them on a copy of the minefield.
+ *
+ * @param field_size size of the minefield
+ * @param seed seed of the round
+ * @param o_types number (1-8), empty (0) or mine (-1) per tile in row major order
+ * @param o_opening_tiles one empty tile per opening that is not revealed by the first reveal
+ * @param o_max_cascade_size upper bound of the tiles a single reveal after the first one can uncover
+ */
+void scoutMinefield(const field_size_t &field_size, seed_t seed, std::vector<int8_t> &o_types, std::vector<index_t> &o_opening_tiles, size_t &o_max_cascade_size)
+{
+  Minefield scout(field_size.rows, field_size.cols);
+  setupMinefield(scout, seed);
+
+  Minefield::tile_info_t info;
+  Minefield::cascade_t revealed_tiles;
+  bool has_revealed_mine;
+
+  o_types.assign(field_size.rows * field_size.cols, 0);
+  o_opening_tiles.clear();
+  o_max_cascade_size = 1ul;
+  for (index_t board_idx = 0l; board_idx < field_size.rows * field_size.cols; board_idx++)
+  {
+    const index_t \
+      row = board_idx / field_size.cols,
+      col = board_idx % field_size.cols;
+
+    scout.getTileInfo(row, col, info);
+    if (info.state == Minefield::TileState::REVEALED)
+    {
+      o_types[board_idx] = info.type;
+      continue;
+    }
+
+    scout.revealTile(row, col, revealed_tiles, has_revealed_mine);
+    size_t nr_empty = 0ul;
+    for (const Minefield::tile_with_position_t &tile: revealed_tiles)
+    {
+      o_types[tile.row * field_size.cols + tile.col] = tile.type;
+      nr_empty += (tile.type == 0);
+    }
+
+    /**
+     * NOTE: Surrounding numbers scanned earlier are already revealed, so the cascade only contains all empty tiles
+     *       of the opening. Every tile of the full cascade is one of them or next to one.
+     */
+    o_max_cascade_size = std::max(o_max_cascade_size, std::max(revealed_tiles.size(), 9ul * nr_empty));
+    if (o_types[board_idx] == 0) o_opening_tiles.push_back(board_idx);
+  }
+}
+
+/**
+ * @brief Parse a whole string as a number.
+ *
+ * @param text the string to parse
+ * @param o_value parsed number
+ *
+ * @returns true if the string is a valid number, false otherwise
+ */
+template<typename value_t>
+bool parseNumber(std::string_view text, value_t &o_value)
+{
+  const std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), o_value);
+
+  return (result.ec == std::errc() && result.ptr == text.data() + text.size());
+}
+
+/* #endregion */
+/* #region benchmarks */
+
+bench_result_t benchFirstReveal(const field_size_t &field_size, Minefield::CountKernel count_kernel)
+{
+  // the first reveal places the mines and counts them, so the kernels are compared on it
+  return runBenchmark(
+    (count_kernel == Minefield::CountKernel::BOX_SUM ? "first_reveal_box_sum" : "first_reveal_scatter"), field_size,
+    [count_kernel](Minefield &minefield, seed_t seed, bench_result_t &io_result)
+    {
+      const field_size_t &field_size = minefield.getFieldSize();
+      Minefield::cascade_t revealed_tiles;
+      bool has_revealed_mine;
+
+      minefield.setCountKernel(count_kernel);
+      minefield.reset(seed);
+      measure(
+        io_result,
+        [&]()
+        {
+          minefield.revealTile(field_size.rows / 2l, field_size.cols / 2l, revealed_tiles, has_revealed_mine);
+        }
+      );
+
+      io_result.nr_ops++;
+      io_result.nr_tiles += field_size.rows * field_size.cols;
+    }
+  );
+}
+
+bench_result_t benchCascade(const field_size_t &field_size, bool is_large)
+{
+  return runBenchmark(
+    (is_large ? "reveal_cascade_large" : "reveal_cascade_small"), field_size,
+    [is_large](Minefield &minefield, seed_t seed, bench_result_t &io_result)
+    {
+      const field_size_t &field_size = minefield.getFieldSize();
+      std::vector<int8_t> types;
+      std::vector<index_t> opening_tiles, targets;
+      size_t max_cascade_size;
+      scoutMinefield(field_size, seed, types, opening_tiles, max_cascade_size);
+      setupMinefield(minefield, seed);
+
+      // small cascades reveal a single number, large ones a whole opening
+      Minefield::tile_info_t info;
+      if (is_large)
+      {
+        targets = opening_tiles;
+      }
+      else
+      {
+        for (index_t board_idx = 0l; board_idx < static_cast<index_t>(types.size()); board_idx++)
+        {
+          if (types[board_idx] <= 0) continue;
+
+          minefield.getTileInfo(board_idx / field_size.cols, board_idx % field_size.cols, info);
+          if (info.state == Minefield::TileState::UNTOUCHED) targets.push_back(board_idx);
+        }
+      }
+      if (targets.size() > BENCH_MAX_OPS_PER_ROUND) targets.resize(BENCH_MAX_OPS_PER_ROUND);
+
+      // reserved up front, so growing it does not count as an allocation of the cascade
+      Minefield::cascade_t revealed_tiles;
+      revealed_tiles.reserve(is_large ? max_cascade_size : 1ul);
+      bool has_revealed_mine;
+      uint64_t nr_revealed = 0ull;
+      measure(
+        io_result,
+        [&]()
+        {
+          for (const index_t board_idx: targets)
+          {
+            minefield.revealTile(board_idx / field_size.cols, board_idx % field_size.cols, revealed_tiles, has_revealed_mine);
+            nr_revealed += revealed_tiles.size();
+          }
+        }
+      );
+
+      io_result.nr_ops += targets.size();
+      io_result.nr_tiles += nr_revealed;
+    }
+  );
+}
+
+bench_result_t benchChord(const field_size_t &field_size)
+{
+  return runBenchmark(
+    "reveal_chord", field_size,
+    [](Minefield &minefield, seed_t seed, bench_result_t &io_result)
+    {
+      const field_size_t &field_size = minefield.getFieldSize();
+      std::vector<int8_t> types;
+      std::vector<index_t> opening_tiles, targets;
+      size_t max_cascade_size;
+      scoutMinefield(field_size, seed, types, opening_tiles, max_cascade_size);
+      setupMinefield(minefield, seed);
+
+      // revealed numbers with unrevealed safe surrounding tiles get their mines flagged and are then chorded
+      Minefield::tile_info_t info;
+      bool is_flagged;
+      for (index_t board_idx = 0l; board_idx < static_cast<index_t>(types.size()) && targets.size() < BENCH_MAX_OPS_PER_ROUND; board_idx++)
+      {
+        const index_t \
+          row = board_idx / field_size.cols,
+          col = board_idx % field_size.cols;
+
+        minefield.getTileInfo(row, col, info);
+        if (info.state != Minefield::TileState::REVEALED || info.type <= 0) continue;
+
+        bool has_safe_untouched = false;
+        for (index_t surrounding_row = std::max(row - 1l, 0l); surrounding_row <= std::min(row + 1l, field_size.rows - 1l); surrounding_row++)
+        {
+          for (index_t surrounding_col = std::max(col - 1l, 0l); surrounding_col <= std::min(col + 1l, field_size.cols - 1l); surrounding_col++)
+          {
+            minefield.getTileInfo(surrounding_row, surrounding_col, info);
+            if (info.state != Minefield::TileState::UNTOUCHED) continue;
+
+            if (types[surrounding_row * field_size.cols + surrounding_col] < 0)
+            {
+              minefield.toggleTileFlag(surrounding_row, surrounding_col, is_flagged);
+            }
+            else
+            {
+              has_safe_untouched = true;
+            }
+          }
+        }
+        if (has_safe_untouched) targets.push_back(board_idx);
+      }
+
+      // a chord reveals up to 8 tiles, each of which may open a cascade
+      Minefield::cascade_t revealed_tiles;
+      revealed_tiles.reserve(std::min(8ul * max_cascade_size, static_cast<size_t>(field_size.rows * field_size.cols)));
+      bool has_revealed_mine;
+      uint64_t nr_revealed = 0ull;
+      measure(
+        io_result,
+        [&]()
+        {
+          for (const index_t board_idx: targets)
+          {
+            minefield.revealTile(board_idx / field_size.cols, board_idx % field_size.cols, revealed_tiles, has_revealed_mine);
+            nr_revealed += revealed_tiles.size();
+          }
+        }
+      );
+
+      io_result.nr_ops += targets.size();
+      io_result.nr_tiles += nr_revealed;
+    }
+  );
+}
+
+bench_result_t benchToggleFlag(const field_size_t &field_size)
+{
+  return runBenchmark(
+    "toggle_flag", field_size,
+    [](Minefield &minefield, seed_t seed, bench_result_t &io_result)
+    {
+      const field_size_t &field_size = minefield.getFieldSize();
+      setupMinefield(minefield, seed);
+
+      Minefield::tile_info_t info;
+      std::vector<index_t> targets;
+      for (index_t board_idx = 0l; board_idx < field_size.rows * field_size.cols && targets.size() < BENCH_MAX_OPS_PER_ROUND; board_idx++)
+      {
+        minefield.getTileInfo(board_idx / field_size.cols, board_idx % field_size.cols, info);
+        if (info.state == Minefield::TileState::UNTOUCHED) targets.push_back(board_idx);
+      }
+
+      bool is_flagged;
+      measure(
+        io_result,
+        [&]()
+        {
+          // flag and unflag again, so the minefield ends up as it started
+          for (const index_t board_idx: targets)
+          {
+            minefield.toggleTileFlag(board_idx / field_size.cols, board_idx % field_size.cols, is_flagged);
+            minefield.toggleTileFlag(board_idx / field_size.cols, board_idx % field_size.cols, is_flagged);
+          }
+        }
+      );
+
+      io_result.nr_ops += 2ul * targets.size();
+      io_result.nr_tiles += 2ul * targets.size();
+    }
+  );
+}
+
+bench_result_t benchCheck(const field_size_t &field_size, bool is_game_won)
+{
+  return runBenchmark(
+    (is_game_won ? "check_game_won" : "check_has_available_moves"), field_size,
+    [is_game_won](Minefield &minefield, seed_t seed, bench_result_t &io_result)
+    {
+      setupMinefield(minefield, seed);
+
+      // keeps the calls from being optimized away
+      volatile bool sink;
+      measure(
+        io_result,
+        [&]()
+        {
+          for (size_t op_idx = 0ul; op_idx < BENCH_CHECK_OPS_PER_ROUND; op_idx++)
+          {
+            sink = (is_game_won ? minefield.checkGameWon() : minefield.checkHasAvailableMoves());
+          }
+        }
+      );
+      static_cast<void>(sink);
+
+      io_result.nr_ops += BENCH_CHECK_OPS_PER_ROUND;
+    }
+  );
+}
+
+/**
+ * @brief Write the results as JSON.
+ *
+ * @param stream stream to write to
+ * @param results benchmark results
+ */
+void writeJson(std::ostream &stream, const std::vector<bench_result_t> &results)
+{
+  stream << "{\n  \"seed\": " << BENCH_SEED << ",\n  \"results\": [\n" << std::setprecision(6);
+  for (size_t result_idx = 0ul; result_idx < results.size(); result_idx++)
+  {
+    const bench_result_t &result = results[result_idx];
+    const double nr_ops = static_cast<double>(result.nr_ops);
+
+    // rates of benchmarks without any operations (e.g. no opening left to reveal) are written as null, JSON has no nan
+    const auto writeRate = [&stream](double amount, double per)
+    {
+      if (per > 0.)
+      {
+        stream << amount / per;
+      }
+      else
+      {
+        stream << "null";
+      }
+    };
+
+    stream
+      << "    {\"benchmark\": \"" << result.name << "\", \"rows\": " << result.field_size.rows << ", \"cols\": " << result.field_size.cols
+      << ", \"ops\": " << result.nr_ops << ", \"seconds\": " << result.seconds
+      << ", \"ns_per_op\": ";
+    writeRate(1e9 * result.seconds, nr_ops);
+    stream << ", \"tiles_per_s\": ";
+    writeRate(static_cast<double>(result.nr_tiles), (result.nr_tiles > 0ull ? result.seconds : 0.));
+    stream << ", \"allocations\": " << result.nr_allocations << ", \"allocations_per_op\": ";
+    writeRate(static_cast<double>(result.nr_allocations), nr_ops);
+    stream << '}' << (result_idx + 1ul < results.size() ? ",\n" : "\n");
+  }
+  stream << "  ]\n}\n";
+}
+
+/* #endregion */
+
+
+int main(int argc, char *argv[])
+{
+# ifdef MW_DEBUG
+  // the core logs every move, which would distort the measurements
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::error);
+# endif // defined(MW_DEBUG)
+
+  std::vector<field_size_t> field_sizes = {{9l, 9l}, {16l, 30l}, {100l, 100l}, {1000l, 1000l}, {10000l, 10000l}};
+  std::string_view output_path;
+  index_t max_tiles = std::numeric_limits<index_t>::max();
+
+  for (int arg_idx = 1; arg_idx < argc; arg_idx++)
+  {
+    const std::string_view option = argv[arg_idx];
+    if (option == "--output" && arg_idx + 1 < argc)
+    {
+      output_path = argv[++arg_idx];
+    }
+    else if (option == "--max-tiles" && arg_idx + 1 < argc && parseNumber(argv[arg_idx + 1], max_tiles))
+    {
+      arg_idx++;
+    }
+    else
+    {
+      std::cerr
+        << "usage: " << argv[0] << " [--output FILE] [--max-tiles N]\n"
+        << "Benchmark the minefield hot paths on fields from 9x9 to 10000x10000 and write the results as JSON.\n"
+        << "  --output FILE    file to write the JSON to (default: standard output)\n"
+        << "  --max-tiles N    skip fields with more tiles, e.g. on machines with little memory\n";
+
+      return (option == "--help" || option == "-h" ? EX_OK : EX_USAGE);
+    }
+  }
+
+  std::vector<bench_result_t> results;
+  for (const field_size_t &field_size: field_sizes)
+  {
+    if (field_size.rows * field_size.cols > max_tiles) continue;
+
+    results.push_back(benchFirstReveal(field_size, Minefield::CountKernel::BOX_SUM));
+    results.push_back(benchFirstReveal(field_size, Minefield::CountKernel::SCATTER));
+    results.push_back(benchCascade(field_size, false));
+    results.push_back(benchCascade(field_size, true));
+    results.push_back(benchChord(field_size));
+    results.push_back(benchToggleFlag(field_size));
+    results.push_back(benchCheck(field_size, true));
+    results.push_back(benchCheck(field_size, false));
+  }
+
+  if (output_path.empty())
+  {
+    writeJson(std::cout, results);
+  }
+  else
+  {
+    std::ofstream output_file{std::string(output_path)};
+    if (!output_file)
+    {
+      std::cerr << "could not open " << output_path << '\n';
+
+      return EX_CANTCREAT;
+    }
+    writeJson(output_file, results);
+  }
+
+  return EX_OK;
+}
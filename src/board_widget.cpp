@@ -0,0 +1,1070 @@
+#include "board_widget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef MW_DEBUG
+#include <sstream>
+#include <iomanip>
+#endif // defined(MW_DEBUG)
+
+
+BoardWidget::BoardWidget(callback_t click_callback):
+  click_callback(click_callback),
+  h_adjustment(Gtk::Adjustment::create(0., 0., 0., TILE_SIZE + SPACING)),
+  v_adjustment(Gtk::Adjustment::create(0., 0., 0., TILE_SIZE + SPACING))
+{
+  MW_SET_CLASS_ORIGIN;
+  MW_SET_FUNC_SCOPE;
+
+  this->set_hexpand(true);
+  this->set_vexpand(true);
+  this->add_events(
+    Gdk::BUTTON_PRESS_MASK | Gdk::BUTTON_RELEASE_MASK |
+    Gdk::POINTER_MOTION_MASK | Gdk::LEAVE_NOTIFY_MASK |
+    Gdk::SCROLL_MASK | Gdk::SMOOTH_SCROLL_MASK
+  );
+
+  const auto scrolled = [this]() -> void
+  {
+    // zoomed out boards shift what has already been painted instead
+    if (!this->checkLevelOfDetail()) this->is_backing_valid = false;
+    this->setHoveredTile(this->getTileAt(this->pointer_x, this->pointer_y));
+    this->queue_draw();
+  };
+  this->h_adjustment->signal_value_changed().connect(scrolled);
+  this->v_adjustment->signal_value_changed().connect(scrolled);
+}
+
+/* #region board state */
+
+void BoardWidget::setSprites(const std::array<sprite_t, 10ul> &reveal_sprites, const state_sprites_t &flagged, const state_sprites_t &untouched)
+{
+  MW_SET_FUNC_SCOPE;
+
+  //! NOTE: in the order of TileSprite
+  std::vector<sprite_t> sprites(reveal_sprites.begin(), reveal_sprites.end());
+  sprites.push_back(untouched.normal);
+  sprites.push_back(untouched.highlighted);
+  sprites.push_back(flagged.normal);
+  sprites.push_back(flagged.highlighted);
+
+  this->sprite_atlas.setSprites(sprites);
+  this->atlas_surface.reset();
+
+  this->is_backing_valid = false;
+  this->queue_draw();
+}
+
+void BoardWidget::resize(index_t rows, index_t cols)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "resize to rows=" << rows << " cols=" << cols;
+
+  // clear the last game with the old layout, afterwards all tiles are untouched and can be shared by the new one
+  this->reset();
+
+  if (rows == this->field_size.rows && cols == this->field_size.cols) return;
+
+  const index_t nr_tiles = rows * cols;
+  this->tile_sprites.resize(nr_tiles, TileSprite::UNTOUCHED);
+  this->is_tile_dirty.resize(nr_tiles, false);
+
+  this->field_size = {rows, cols};
+  this->hovered_idx = -1l;
+  this->updateAdjustments();
+  this->h_adjustment->set_value(0.);
+  this->v_adjustment->set_value(0.);
+
+  this->resetMinimap();
+}
+
+void BoardWidget::reset()
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (this->changed_tiles.size() >= this->tile_sprites.size())
+  {
+    std::fill(this->tile_sprites.begin(), this->tile_sprites.end(), TileSprite::UNTOUCHED);
+  }
+  else
+  {
+    for (const index_t idx: this->changed_tiles)
+    {
+      this->tile_sprites[idx] = TileSprite::UNTOUCHED;
+    }
+  }
+  this->changed_tiles.clear();
+
+  for (const index_t idx: this->dirty_tiles)
+  {
+    this->is_tile_dirty[idx] = false;
+  }
+  this->dirty_tiles.clear();
+  this->dirty_x0 = this->dirty_x1 = 0;
+  this->clearDirtyLodPixels();
+
+  this->resetMinimap();
+
+  this->is_backing_valid = false;
+  this->queue_draw();
+}
+
+void BoardWidget::setTileFlag(index_t row, index_t col, bool flag)
+{
+  this->setTileSprite(row * this->field_size.cols + col, (flag ? TileSprite::FLAGGED : TileSprite::UNTOUCHED));
+}
+
+void BoardWidget::revealTiles(const Minefield::cascade_t &cascade)
+{
+  MW_SET_FUNC_SCOPE;
+
+  bool has_dirty_area_grown = false;
+  for (const Minefield::tile_with_position_t &tile: cascade)
+  {
+    has_dirty_area_grown |= this->updateTileSprite(tile.row * this->field_size.cols + tile.col, static_cast<uint8_t>(tile.type + 1));
+  }
+
+  if (has_dirty_area_grown) this->invalidateDirtyArea();
+}
+
+void BoardWidget::resetTiles(const Minefield::cascade_t &cascade)
+{
+  MW_SET_FUNC_SCOPE;
+
+  bool has_dirty_area_grown = false;
+  for (const Minefield::tile_with_position_t &tile: cascade)
+  {
+    has_dirty_area_grown |= this->updateTileSprite(tile.row * this->field_size.cols + tile.col, TileSprite::UNTOUCHED);
+  }
+
+  if (has_dirty_area_grown) this->invalidateDirtyArea();
+}
+
+Glib::RefPtr<Gtk::Adjustment> BoardWidget::getHAdjustment()
+{
+  return this->h_adjustment;
+}
+
+Glib::RefPtr<Gtk::Adjustment> BoardWidget::getVAdjustment()
+{
+  return this->v_adjustment;
+}
+
+# ifdef MW_DEBUG
+void BoardWidget::setInformationCallback(const sigc::slot<std::string, index_t, index_t> &callback)
+{
+  this->set_has_tooltip();
+  this->signal_query_tooltip().connect(
+    [this, callback](int x, int y, bool, const Glib::RefPtr<Gtk::Tooltip> &tooltip)
+    {
+      const index_t idx = this->getTileAt(x, y);
+      if (idx < 0l) return false;
+
+      const index_t \
+        row = idx / this->field_size.cols,
+        col = idx % this->field_size.cols;
+
+      std::stringstream text;
+      text << '(' << std::setw(2) << row << " | " << std::setw(2) << col << ")\n" << callback(row, col);
+      tooltip->set_text(text.str());
+
+      return true;
+    }
+  );
+}
+# endif // defined(MW_DEBUG)
+
+/* #endregion */
+/* #region drawing */
+
+bool BoardWidget::on_draw(const Cairo::RefPtr<Cairo::Context> &context)
+{
+  MW_SET_FUNC_SCOPE;
+
+  const int \
+    width  = this->get_allocated_width(),
+    height = this->get_allocated_height();
+
+  if (this->checkLevelOfDetail())
+  {
+    if (!this->lod_surface || this->lod_surface->get_width() != width || this->lod_surface->get_height() != height)
+    {
+      this->lod_surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, width, height);
+      this->is_lod_pixel_dirty.assign(static_cast<size_t>(width) * height, false);
+      this->is_backing_valid = false;
+    }
+
+    double origin_x, origin_y;
+    this->getOrigin(origin_x, origin_y);
+
+    this->lod_surface->flush();
+    if (this->is_backing_valid)
+    {
+      this->scrollLevelOfDetail(static_cast<int>(origin_x - this->lod_origin_x), static_cast<int>(origin_y - this->lod_origin_y));
+
+      for (const lod_pixel_t &pixel: this->dirty_lod_pixels)
+      {
+        const int \
+          x = static_cast<int>(pixel.x + origin_x),
+          y = static_cast<int>(pixel.y + origin_y);
+        this->drawLevelOfDetail(std::max(x, 0), std::max(y, 0), std::min(x + this->tile_size, width), std::min(y + this->tile_size, height));
+      }
+    }
+    else
+    {
+      this->drawLevelOfDetail(0, 0, width, height);
+      this->is_backing_valid = true;
+    }
+    this->lod_surface->mark_dirty();
+    this->lod_origin_x = origin_x;
+    this->lod_origin_y = origin_y;
+
+    context->set_source(this->lod_surface, 0., 0.);
+  }
+  else
+  {
+    if (!this->backing_surface || this->backing_width != width || this->backing_height != height)
+    {
+      this->backing_surface = this->get_window()->create_similar_surface(Cairo::CONTENT_COLOR_ALPHA, width, height);
+      this->backing_width = width;
+      this->backing_height = height;
+      this->is_backing_valid = false;
+    }
+
+    // looked up once per frame, a new atlas means a new zoom level or screen scale so everything gets repainted
+    Cairo::RefPtr<Cairo::ImageSurface> atlas_surface = this->sprite_atlas.getAtlas(this->tile_size, this->get_scale_factor());
+    if (atlas_surface != this->atlas_surface)
+    {
+      this->atlas_surface = atlas_surface;
+      this->is_backing_valid = false;
+    }
+
+    Cairo::RefPtr<Cairo::Context> backing_context = Cairo::Context::create(this->backing_surface);
+    if (this->is_backing_valid)
+    {
+      for (const index_t idx: this->dirty_tiles)
+      {
+        this->drawTile(backing_context, idx);
+      }
+    }
+    else
+    {
+      backing_context->save();
+      backing_context->set_operator(Cairo::OPERATOR_CLEAR);
+      backing_context->paint();
+      backing_context->restore();
+
+      // only the tiles inside the widget get painted, no matter how large the board is
+      double origin_x, origin_y;
+      this->getOrigin(origin_x, origin_y);
+      const index_t \
+        first_row = std::clamp(static_cast<index_t>(std::floor(-origin_y / this->tile_pitch)), 0l, this->field_size.rows),
+        last_row  = std::clamp(static_cast<index_t>(std::ceil((height - origin_y) / this->tile_pitch)), 0l, this->field_size.rows),
+        first_col = std::clamp(static_cast<index_t>(std::floor(-origin_x / this->tile_pitch)), 0l, this->field_size.cols),
+        last_col  = std::clamp(static_cast<index_t>(std::ceil((width - origin_x) / this->tile_pitch)), 0l, this->field_size.cols);
+
+      for (index_t row = first_row; row < last_row; row++)
+      {
+        for (index_t col = first_col; col < last_col; col++)
+        {
+          this->drawTile(backing_context, row * this->field_size.cols + col);
+        }
+      }
+
+      this->is_backing_valid = true;
+    }
+
+    context->set_source(this->backing_surface, 0., 0.);
+  }
+  context->paint();
+
+  for (const index_t idx: this->dirty_tiles)
+  {
+    this->is_tile_dirty[idx] = false;
+  }
+  this->dirty_tiles.clear();
+  this->dirty_x0 = this->dirty_x1 = 0;
+  this->clearDirtyLodPixels();
+
+  this->drawMinimap(context);
+
+  return true;
+}
+
+void BoardWidget::on_size_allocate(Gtk::Allocation &allocation)
+{
+  Gtk::DrawingArea::on_size_allocate(allocation);
+
+  this->updateAdjustments();
+  this->is_backing_valid = false;
+}
+
+void BoardWidget::setTileSprite(index_t idx, uint8_t sprite)
+{
+  if (this->updateTileSprite(idx, sprite)) this->invalidateDirtyArea();
+}
+
+bool BoardWidget::updateTileSprite(index_t idx, uint8_t sprite)
+{
+  if (this->tile_sprites[idx] == sprite) return false;
+
+  const uint8_t old_sprite = this->tile_sprites[idx];
+  if (old_sprite == TileSprite::UNTOUCHED) this->changed_tiles.push_back(idx);
+  this->tile_sprites[idx] = sprite;
+
+  const bool has_minimap_changed = this->updateMinimap(idx, old_sprite, sprite);
+
+  return this->markTileDirty(idx) || has_minimap_changed;
+}
+
+bool BoardWidget::markTileDirty(index_t idx)
+{
+  if (this->is_tile_dirty[idx]) return false;
+
+  double origin_x, origin_y;
+  this->getOrigin(origin_x, origin_y);
+
+  const int \
+    x = static_cast<int>(std::floor(origin_x + this->toPixels(idx % this->field_size.cols))),
+    y = static_cast<int>(std::floor(origin_y + this->toPixels(idx / this->field_size.cols)));
+
+  // tiles outside the widget get painted once they are scrolled into view
+  if (x + this->tile_size <= 0 || y + this->tile_size <= 0 || x >= this->get_allocated_width() || y >= this->get_allocated_height()) return false;
+
+  // the whole backing surface gets repainted anyway, so there is nothing to gather
+  if (!this->is_backing_valid) return false;
+
+  if (this->checkLevelOfDetail())
+  {
+    if (!this->markLodPixelDirty(x, y, origin_x, origin_y)) return false;
+  }
+  else
+  {
+    this->dirty_tiles.push_back(idx);
+    this->is_tile_dirty[idx] = true;
+  }
+
+  /**
+   * NOTE: Invalidating every tile on its own makes gdk merge more and more rectangles into the invalid region.
+   *       Growing a single bounding box instead keeps that constant, the copy from the backing surface is cheap.
+   */
+  const int \
+    tile_x1 = x + this->tile_size + 1,
+    tile_y1 = y + this->tile_size + 1;
+  if (this->dirty_x0 >= this->dirty_x1)
+  {
+    this->dirty_x0 = x;
+    this->dirty_y0 = y;
+    this->dirty_x1 = tile_x1;
+    this->dirty_y1 = tile_y1;
+
+    return true;
+  }
+
+  if (x >= this->dirty_x0 && y >= this->dirty_y0 && tile_x1 <= this->dirty_x1 && tile_y1 <= this->dirty_y1) return false;
+
+  this->dirty_x0 = std::min(this->dirty_x0, x);
+  this->dirty_y0 = std::min(this->dirty_y0, y);
+  this->dirty_x1 = std::max(this->dirty_x1, tile_x1);
+  this->dirty_y1 = std::max(this->dirty_y1, tile_y1);
+
+  return true;
+}
+
+bool BoardWidget::markLodPixelDirty(int x, int y, double origin_x, double origin_y)
+{
+  const int width = this->get_allocated_width();
+  const size_t pixel_idx = static_cast<size_t>(std::max(y, 0)) * width + std::max(x, 0);
+  if (pixel_idx >= this->is_lod_pixel_dirty.size())
+  {
+    this->is_backing_valid = false;
+    this->queue_draw();
+
+    return false;
+  }
+  if (this->is_lod_pixel_dirty[pixel_idx]) return false;
+
+  /**
+   * NOTE: Each dirty pixel recounts all of its tiles. Past a quarter of the visible pixels, painting the whole
+   *       widget in one sweep is cheaper, and it also bounds the memory of the dirty list.
+   */
+  const size_t max_dirty_pixels = static_cast<size_t>(width) * this->get_allocated_height() / (4 * this->tile_size * this->tile_size);
+  if (this->dirty_lod_pixels.size() >= max_dirty_pixels)
+  {
+    this->clearDirtyLodPixels();
+    this->is_backing_valid = false;
+    this->queue_draw();
+
+    return false;
+  }
+
+  this->is_lod_pixel_dirty[pixel_idx] = true;
+  // relative to the board, so it stays valid if the board gets scrolled before the next draw
+  this->dirty_lod_pixels.push_back(lod_pixel_t{x - origin_x, y - origin_y});
+
+  return true;
+}
+
+void BoardWidget::clearDirtyLodPixels()
+{
+  if (this->dirty_lod_pixels.empty()) return;
+
+  std::fill(this->is_lod_pixel_dirty.begin(), this->is_lod_pixel_dirty.end(), false);
+  this->dirty_lod_pixels.clear();
+}
+
+void BoardWidget::invalidateDirtyArea()
+{
+  if (this->dirty_x0 < this->dirty_x1)
+  {
+    this->queue_draw_area(this->dirty_x0, this->dirty_y0, this->dirty_x1 - this->dirty_x0, this->dirty_y1 - this->dirty_y0);
+  }
+
+  double minimap_x, minimap_y, minimap_scale;
+  if (this->is_minimap_dirty && this->getMinimapArea(minimap_x, minimap_y, minimap_scale))
+  {
+    this->queue_draw_area(
+      static_cast<int>(minimap_x) - 1, static_cast<int>(minimap_y) - 1,
+      static_cast<int>(std::ceil(this->minimap_cols * minimap_scale)) + 2, static_cast<int>(std::ceil(this->minimap_rows * minimap_scale)) + 2
+    );
+  }
+}
+
+void BoardWidget::drawTile(const Cairo::RefPtr<Cairo::Context> &context, index_t idx)
+{
+  double origin_x, origin_y;
+  this->getOrigin(origin_x, origin_y);
+
+  const double \
+    x = std::round(origin_x + (idx % this->field_size.cols) * this->tile_pitch),
+    y = std::round(origin_y + (idx / this->field_size.cols) * this->tile_pitch);
+
+  uint8_t sprite = this->tile_sprites[idx];
+  if (idx == this->hovered_idx && checkSpriteHighlightable(sprite)) sprite++;
+
+  context->set_source(this->atlas_surface, x - sprite * this->tile_size, y);
+  context->rectangle(x, y, this->tile_size, this->tile_size);
+  context->fill();
+}
+
+/* #endregion */
+/* #region input */
+
+bool BoardWidget::on_button_press_event(GdkEventButton *button)
+{
+  if (button->button != GDK_BUTTON_PRIMARY || !this->checkMinimapAt(button->x, button->y)) return false;
+
+  this->is_minimap_dragging = true;
+  this->scrollToMinimap(button->x, button->y);
+
+  return true;
+}
+
+bool BoardWidget::on_button_release_event(GdkEventButton *button)
+{
+  MW_SET_FUNC_SCOPE;
+
+  // releasing the minimap must not reveal the tile below the pointer
+  if (this->is_minimap_dragging && button->button == GDK_BUTTON_PRIMARY)
+  {
+    this->is_minimap_dragging = false;
+
+    return true;
+  }
+
+  const index_t idx = this->getTileAt(button->x, button->y);
+  if (idx < 0l) return false;
+
+  const index_t \
+    row = idx / this->field_size.cols,
+    col = idx % this->field_size.cols;
+
+  if (button->button == GDK_BUTTON_PRIMARY)
+  {
+    this->click_callback(true, row, col);
+  }
+  else if (button->button == GDK_BUTTON_SECONDARY)
+  {
+    this->click_callback(false, row, col);
+  }
+
+  return false;
+}
+
+bool BoardWidget::on_motion_notify_event(GdkEventMotion *motion)
+{
+  this->pointer_x = motion->x;
+  this->pointer_y = motion->y;
+
+  if (this->is_minimap_dragging)
+  {
+    this->scrollToMinimap(motion->x, motion->y);
+
+    return true;
+  }
+
+  this->setHoveredTile(this->getTileAt(motion->x, motion->y));
+
+  return false;
+}
+
+bool BoardWidget::on_leave_notify_event(GdkEventCrossing *)
+{
+  this->pointer_x = this->pointer_y = -1.;
+  this->setHoveredTile(-1l);
+
+  return false;
+}
+
+bool BoardWidget::on_scroll_event(GdkEventScroll *scroll)
+{
+  double \
+    delta_x = 0.,
+    delta_y = 0.;
+
+  switch (scroll->direction)
+  {
+  case GDK_SCROLL_UP:
+    delta_y = -1.;
+    break;
+  case GDK_SCROLL_DOWN:
+    delta_y = 1.;
+    break;
+  case GDK_SCROLL_LEFT:
+    delta_x = -1.;
+    break;
+  case GDK_SCROLL_RIGHT:
+    delta_x = 1.;
+    break;
+  case GDK_SCROLL_SMOOTH:
+    delta_x = scroll->delta_x;
+    delta_y = scroll->delta_y;
+    break;
+  }
+
+  if (scroll->state & GDK_CONTROL_MASK)
+  {
+    if (delta_y != 0.) this->zoom(-delta_y, scroll->x, scroll->y);
+
+    return true;
+  }
+
+  // like scrolled windows, shift turns vertical into horizontal scrolling
+  if (scroll->state & GDK_SHIFT_MASK) std::swap(delta_x, delta_y);
+
+  //! NOTE: set_value clamps to the scroll range
+  this->h_adjustment->set_value(this->h_adjustment->get_value() + delta_x * this->h_adjustment->get_step_increment());
+  this->v_adjustment->set_value(this->v_adjustment->get_value() + delta_y * this->v_adjustment->get_step_increment());
+
+  return true;
+}
+
+index_t BoardWidget::getTileAt(double x, double y)
+{
+  if (x < 0. || y < 0. || x >= this->get_allocated_width() || y >= this->get_allocated_height()) return -1l;
+  if (this->checkLevelOfDetail() || this->checkMinimapAt(x, y)) return -1l;
+
+  double origin_x, origin_y;
+  this->getOrigin(origin_x, origin_y);
+
+  const double \
+    board_x = x - origin_x,
+    board_y = y - origin_y;
+  if (board_x < 0. || board_y < 0.) return -1l;
+
+  const index_t \
+    row = static_cast<index_t>(board_y / this->tile_pitch),
+    col = static_cast<index_t>(board_x / this->tile_pitch);
+  if (row >= this->field_size.rows || col >= this->field_size.cols) return -1l;
+
+  // the spacing between tiles does not belong to any of them
+  if (board_x - col * this->tile_pitch >= this->tile_size || board_y - row * this->tile_pitch >= this->tile_size) return -1l;
+
+  return row * this->field_size.cols + col;
+}
+
+void BoardWidget::setHoveredTile(index_t idx)
+{
+  if (idx == this->hovered_idx) return;
+
+  const index_t previous_idx = this->hovered_idx;
+  this->hovered_idx = idx;
+
+  // revealed tiles look the same either way, so sweeping across them does not repaint anything
+  bool has_dirty_area_grown = false;
+  if (previous_idx >= 0l && checkSpriteHighlightable(this->tile_sprites[previous_idx])) has_dirty_area_grown |= this->markTileDirty(previous_idx);
+  if (idx >= 0l && checkSpriteHighlightable(this->tile_sprites[idx])) has_dirty_area_grown |= this->markTileDirty(idx);
+
+  if (has_dirty_area_grown) this->invalidateDirtyArea();
+}
+
+inline bool BoardWidget::checkSpriteHighlightable(uint8_t sprite)
+{
+  return sprite == TileSprite::UNTOUCHED || sprite == TileSprite::FLAGGED;
+}
+
+/* #endregion */
+/* #region layout */
+
+void BoardWidget::zoom(double steps, double anchor_x, double anchor_y)
+{
+  int \
+    tile_size = this->tile_size,
+    lod_shift = this->lod_shift;
+
+  if (tile_size >= MIN_TILE_SIZE && (steps > 0. || tile_size > MIN_TILE_SIZE))
+  {
+    tile_size = static_cast<int>(std::round(tile_size * std::pow(ZOOM_STEP, steps)));
+    // small steps of smooth scrolling would never change small tile sizes otherwise
+    if (tile_size == this->tile_size) tile_size += (steps > 0. ? 1 : -1);
+
+    // zooming out stops at the smallest sprites before going on with plain colors
+    tile_size = std::clamp(tile_size, static_cast<int>(MIN_TILE_SIZE), static_cast<int>(MAX_TILE_SIZE));
+    this->lod_zoom_steps = 0.;
+  }
+  else
+  {
+    this->lod_zoom_steps += steps;
+
+    for (; this->lod_zoom_steps >= 1.; this->lod_zoom_steps -= 1.)
+    {
+      if (lod_shift > 0)
+      {
+        lod_shift--;
+      }
+      else
+      {
+        tile_size *= 2;
+        if (tile_size >= MIN_TILE_SIZE) break;
+      }
+    }
+
+    for (; this->lod_zoom_steps <= -1.; this->lod_zoom_steps += 1.)
+    {
+      // there is no point in zooming out any further once the whole board is visible
+      if (
+        std::ldexp(this->field_size.cols * tile_size, -lod_shift) <= this->get_allocated_width() &&
+        std::ldexp(this->field_size.rows * tile_size, -lod_shift) <= this->get_allocated_height()
+      ) break;
+
+      if (tile_size > 1)
+      {
+        tile_size /= 2;
+      }
+      else if (lod_shift < MAX_LOD_SHIFT)
+      {
+        lod_shift++;
+      }
+    }
+
+    if (tile_size >= MIN_TILE_SIZE || std::abs(this->lod_zoom_steps) >= 1.) this->lod_zoom_steps = 0.;
+  }
+
+  this->setZoom(tile_size, lod_shift, anchor_x, anchor_y);
+}
+
+void BoardWidget::setZoom(int tile_size, int lod_shift, double anchor_x, double anchor_y)
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (tile_size == this->tile_size && lod_shift == this->lod_shift) return;
+
+  MW_LOG(trace) << "zooming to tile size=" << tile_size << " lod shift=" << lod_shift;
+
+  // board position under the anchor in tiles, which stays under it
+  double origin_x, origin_y;
+  this->getOrigin(origin_x, origin_y);
+  const double \
+    anchor_col = this->toTiles(anchor_x - origin_x),
+    anchor_row = this->toTiles(anchor_y - origin_y);
+
+  this->tile_size = tile_size;
+  this->tile_spacing = static_cast<int>(tile_size * SPACING / TILE_SIZE);
+  this->tile_pitch = this->tile_size + this->tile_spacing;
+  this->lod_shift = lod_shift;
+
+  this->updateAdjustments();
+  this->h_adjustment->set_value(this->toPixels(anchor_col) - anchor_x);
+  this->v_adjustment->set_value(this->toPixels(anchor_row) - anchor_y);
+
+  this->is_backing_valid = false;
+  this->setHoveredTile(this->getTileAt(this->pointer_x, this->pointer_y));
+  this->queue_draw();
+}
+
+inline bool BoardWidget::checkLevelOfDetail()
+{
+  return this->tile_size < MIN_TILE_SIZE;
+}
+
+inline double BoardWidget::toPixels(double tiles)
+{
+  return std::ldexp(tiles * this->tile_pitch, -this->lod_shift);
+}
+
+inline double BoardWidget::toTiles(double pixels)
+{
+  return std::ldexp(pixels, this->lod_shift) / this->tile_pitch;
+}
+
+void BoardWidget::getOrigin(double &o_x, double &o_y)
+{
+  const double \
+    board_width  = this->toPixels(this->field_size.cols) - this->tile_spacing,
+    board_height = this->toPixels(this->field_size.rows) - this->tile_spacing;
+  const int \
+    width  = this->get_allocated_width(),
+    height = this->get_allocated_height();
+
+  o_x = (board_width  < width  ? std::floor((width  - board_width)  / 2.) : -std::round(this->h_adjustment->get_value()));
+  o_y = (board_height < height ? std::floor((height - board_height) / 2.) : -std::round(this->v_adjustment->get_value()));
+}
+
+void BoardWidget::updateAdjustments()
+{
+  const double \
+    board_width  = std::max(std::ceil(this->toPixels(this->field_size.cols)) - this->tile_spacing, 0.),
+    board_height = std::max(std::ceil(this->toPixels(this->field_size.rows)) - this->tile_spacing, 0.),
+    step   = std::max(this->toPixels(1.), static_cast<double>(MIN_TILE_SIZE)),
+    width  = this->get_allocated_width(),
+    height = this->get_allocated_height();
+
+  this->h_adjustment->configure(this->h_adjustment->get_value(), 0., board_width,  step, .9 * width,  width);
+  this->v_adjustment->configure(this->v_adjustment->get_value(), 0., board_height, step, .9 * height, height);
+}
+
+/* #endregion */
+/* #region level of detail */
+
+const std::array<uint32_t, BoardWidget::LodState::NR_LOD_STATES> BoardWidget::lod_colors = {
+  LOD_COLOR_UNTOUCHED, LOD_COLOR_REVEALED, LOD_COLOR_FLAGGED, LOD_COLOR_MINE
+};
+
+void BoardWidget::drawLevelOfDetail(int x0, int y0, int x1, int y1)
+{
+  if (x0 >= x1 || y0 >= y1) return;
+
+  double origin_x, origin_y;
+  this->getOrigin(origin_x, origin_y);
+
+  uint32_t *const pixels = reinterpret_cast<uint32_t *>(this->lod_surface->get_data());
+  const int stride = this->lod_surface->get_stride() / static_cast<int>(sizeof(uint32_t));
+  const index_t \
+    offset_x = static_cast<index_t>(origin_x),
+    offset_y = static_cast<index_t>(origin_y),
+    lod_size = 1l << this->lod_shift;
+
+  // first column of each pixel, -1 outside of the board
+  std::vector<index_t> &first_cols = this->lod_first_cols;
+  first_cols.resize(x1 - x0);
+  for (int x = x0; x < x1; x++)
+  {
+    const index_t board_x = x - offset_x;
+    const index_t first_col = (board_x < 0l ? -1l : (board_x << this->lod_shift) / this->tile_size);
+    first_cols[x - x0] = (first_col < this->field_size.cols ? first_col : -1l);
+  }
+
+  for (int y = y0; y < y1; y++)
+  {
+    uint32_t *const pixel_row = pixels + y * stride + x0;
+    const index_t board_y = y - offset_y;
+    const index_t first_row = (board_y < 0l ? -1l : (board_y << this->lod_shift) / this->tile_size);
+
+    if (first_row < 0l || first_row >= this->field_size.rows)
+    {
+      std::fill(pixel_row, pixel_row + (x1 - x0), 0u);
+      continue;
+    }
+
+    if (lod_size == 1l)
+    {
+      const uint8_t *const sprite_row = this->tile_sprites.data() + first_row * this->field_size.cols;
+      for (int x = 0; x < x1 - x0; x++)
+      {
+        pixel_row[x] = (first_cols[x] < 0l ? 0u : 0xff000000u | lod_colors[getLodState(sprite_row[first_cols[x]])]);
+      }
+      continue;
+    }
+
+    /**
+     * NOTE: The tiles of a whole row of pixels get counted one tile row after the other, so the tiles are read in
+     *       the order they are stored instead of jumping between rows for every pixel.
+     */
+    std::vector<lod_counts_t> &counts = this->lod_row_counts;
+    counts.assign(x1 - x0, lod_counts_t{});
+    const index_t last_row = std::min(first_row + lod_size, this->field_size.rows);
+    for (index_t row = first_row; row < last_row; row++)
+    {
+      const uint8_t *const sprite_row = this->tile_sprites.data() + row * this->field_size.cols;
+      for (int x = 0; x < x1 - x0; x++)
+      {
+        if (first_cols[x] < 0l) continue;
+
+        const index_t last_col = std::min(first_cols[x] + lod_size, this->field_size.cols);
+        for (index_t col = first_cols[x]; col < last_col; col++)
+        {
+          counts[x][getLodState(sprite_row[col])]++;
+        }
+      }
+    }
+
+    for (int x = 0; x < x1 - x0; x++)
+    {
+      pixel_row[x] = blendLodColor(counts[x]);
+    }
+  }
+}
+
+void BoardWidget::scrollLevelOfDetail(int delta_x, int delta_y)
+{
+  if (delta_x == 0 && delta_y == 0) return;
+
+  const int \
+    width  = this->lod_surface->get_width(),
+    height = this->lod_surface->get_height();
+
+  if (std::abs(delta_x) >= width || std::abs(delta_y) >= height)
+  {
+    this->drawLevelOfDetail(0, 0, width, height);
+
+    return;
+  }
+
+  uint32_t *const pixels = reinterpret_cast<uint32_t *>(this->lod_surface->get_data());
+  const int stride = this->lod_surface->get_stride() / static_cast<int>(sizeof(uint32_t));
+  const int \
+    row_length = width - std::abs(delta_x),
+    src_x = std::max(-delta_x, 0),
+    dst_x = std::max(delta_x, 0);
+
+  // rows are moved in the opposite direction of the shift, so none gets overwritten before it is moved
+  if (delta_y > 0)
+  {
+    for (int y = height - 1; y >= delta_y; y--)
+    {
+      std::memmove(pixels + y * stride + dst_x, pixels + (y - delta_y) * stride + src_x, row_length * sizeof(uint32_t));
+    }
+  }
+  else
+  {
+    for (int y = 0; y < height + delta_y; y++)
+    {
+      std::memmove(pixels + y * stride + dst_x, pixels + (y - delta_y) * stride + src_x, row_length * sizeof(uint32_t));
+    }
+  }
+
+  // paint the uncovered stripes
+  const int \
+    kept_y0 = std::max(delta_y, 0),
+    kept_y1 = height + std::min(delta_y, 0);
+  this->drawLevelOfDetail(0, 0, width, kept_y0);
+  this->drawLevelOfDetail(0, kept_y1, width, height);
+  this->drawLevelOfDetail(0, kept_y0, dst_x, kept_y1);
+  this->drawLevelOfDetail(dst_x + row_length, kept_y0, width, kept_y1);
+}
+
+uint32_t BoardWidget::blendLodColor(const lod_counts_t &counts)
+{
+  uint64_t \
+    total = 0ull,
+    red   = 0ull,
+    green = 0ull,
+    blue  = 0ull;
+  for (size_t state = 0ul; state < counts.size(); state++)
+  {
+    total += counts[state];
+    red   += counts[state] * ((lod_colors[state] >> 16u) & 0xffu);
+    green += counts[state] * ((lod_colors[state] >>  8u) & 0xffu);
+    blue  += counts[state] * ( lod_colors[state]         & 0xffu);
+  }
+
+  if (total == 0ull) return 0u;
+
+  return 0xff000000u | static_cast<uint32_t>((red / total) << 16u | (green / total) << 8u | (blue / total));
+}
+
+inline BoardWidget::LodState BoardWidget::getLodState(uint8_t sprite)
+{
+  switch (sprite)
+  {
+  case TileSprite::MINE:
+    return LodState::LOD_MINE;
+  case TileSprite::UNTOUCHED:
+  case TileSprite::UNTOUCHED_HIGHLIGHTED:
+    return LodState::LOD_UNTOUCHED;
+  case TileSprite::FLAGGED:
+  case TileSprite::FLAGGED_HIGHLIGHTED:
+    return LodState::LOD_FLAGGED;
+  default:
+    return LodState::LOD_REVEALED;
+  }
+}
+
+/* #endregion */
+/* #region minimap */
+
+void BoardWidget::resetMinimap()
+{
+  MW_SET_FUNC_SCOPE;
+
+  const index_t longer_side = std::max(this->field_size.rows, this->field_size.cols);
+  this->minimap_block = std::max((longer_side + MINIMAP_SIZE - 1l) / MINIMAP_SIZE, 1l);
+  this->minimap_rows = (this->field_size.rows + this->minimap_block - 1l) / this->minimap_block;
+  this->minimap_cols = (this->field_size.cols + this->minimap_block - 1l) / this->minimap_block;
+
+  if (
+    !this->minimap_surface ||
+    this->minimap_surface->get_width() != this->minimap_cols || this->minimap_surface->get_height() != this->minimap_rows
+  )
+  {
+    this->minimap_surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, static_cast<int>(this->minimap_cols), static_cast<int>(this->minimap_rows));
+  }
+  this->minimap_surface->flush();
+
+  uint32_t *const pixels = reinterpret_cast<uint32_t *>(this->minimap_surface->get_data());
+  const index_t stride = this->minimap_surface->get_stride() / static_cast<index_t>(sizeof(uint32_t));
+
+  // blocks at the lower and right edge may be cut off
+  this->minimap_counts.assign(this->minimap_rows * this->minimap_cols, lod_counts_t{});
+  for (index_t minimap_row = 0l; minimap_row < this->minimap_rows; minimap_row++)
+  {
+    const index_t block_rows = std::min(this->minimap_block, this->field_size.rows - minimap_row * this->minimap_block);
+    for (index_t minimap_col = 0l; minimap_col < this->minimap_cols; minimap_col++)
+    {
+      const index_t block_cols = std::min(this->minimap_block, this->field_size.cols - minimap_col * this->minimap_block);
+
+      lod_counts_t &counts = this->minimap_counts[minimap_row * this->minimap_cols + minimap_col];
+      counts[LodState::LOD_UNTOUCHED] = static_cast<uint32_t>(block_rows * block_cols);
+      pixels[minimap_row * stride + minimap_col] = blendLodColor(counts);
+    }
+  }
+
+  this->minimap_surface->mark_dirty();
+  this->is_minimap_dirty = false;
+}
+
+bool BoardWidget::updateMinimap(index_t idx, uint8_t old_sprite, uint8_t new_sprite)
+{
+  const LodState \
+    old_state = getLodState(old_sprite),
+    new_state = getLodState(new_sprite);
+  if (old_state == new_state) return false;
+
+  const index_t \
+    minimap_row = idx / this->field_size.cols / this->minimap_block,
+    minimap_col = idx % this->field_size.cols / this->minimap_block;
+
+  lod_counts_t &counts = this->minimap_counts[minimap_row * this->minimap_cols + minimap_col];
+  counts[old_state]--;
+  counts[new_state]++;
+
+  //! NOTE: the surface only gets marked dirty once before it is drawn the next time
+  uint32_t *const pixels = reinterpret_cast<uint32_t *>(this->minimap_surface->get_data());
+  const index_t stride = this->minimap_surface->get_stride() / static_cast<index_t>(sizeof(uint32_t));
+  const uint32_t color = blendLodColor(counts);
+  if (pixels[minimap_row * stride + minimap_col] == color) return false;
+
+  pixels[minimap_row * stride + minimap_col] = color;
+
+  const bool was_minimap_dirty = this->is_minimap_dirty;
+  this->is_minimap_dirty = true;
+
+  return !was_minimap_dirty;
+}
+
+void BoardWidget::drawMinimap(const Cairo::RefPtr<Cairo::Context> &context)
+{
+  double minimap_x, minimap_y, minimap_scale;
+  if (!this->getMinimapArea(minimap_x, minimap_y, minimap_scale)) return;
+
+  if (this->is_minimap_dirty)
+  {
+    this->minimap_surface->mark_dirty();
+    this->is_minimap_dirty = false;
+  }
+
+  const double \
+    minimap_width  = this->minimap_cols * minimap_scale,
+    minimap_height = this->minimap_rows * minimap_scale;
+
+  context->save();
+
+  context->set_source_rgb(0., 0., 0.);
+  context->rectangle(minimap_x - 1., minimap_y - 1., minimap_width + 2., minimap_height + 2.);
+  context->fill();
+
+  // every minimap pixel stays a sharp square
+  Cairo::RefPtr<Cairo::SurfacePattern> pattern = Cairo::SurfacePattern::create(this->minimap_surface);
+  pattern->set_filter(Cairo::FILTER_NEAREST);
+  context->translate(minimap_x, minimap_y);
+  context->scale(minimap_scale, minimap_scale);
+  context->set_source(pattern);
+  context->rectangle(0., 0., this->minimap_cols, this->minimap_rows);
+  context->fill();
+
+  context->restore();
+
+  // outline of the visible part of the board
+  double origin_x, origin_y;
+  this->getOrigin(origin_x, origin_y);
+  const double \
+    tile_scale = minimap_scale / this->minimap_block,
+    first_col  = std::clamp(this->toTiles(-origin_x), 0., static_cast<double>(this->field_size.cols)),
+    last_col   = std::clamp(this->toTiles(this->get_allocated_width() - origin_x), 0., static_cast<double>(this->field_size.cols)),
+    first_row  = std::clamp(this->toTiles(-origin_y), 0., static_cast<double>(this->field_size.rows)),
+    last_row   = std::clamp(this->toTiles(this->get_allocated_height() - origin_y), 0., static_cast<double>(this->field_size.rows));
+
+  context->save();
+  context->set_source_rgb(1., 1., 1.);
+  context->set_line_width(1.);
+  context->rectangle(
+    std::round(minimap_x + first_col * tile_scale) + .5, std::round(minimap_y + first_row * tile_scale) + .5,
+    std::max(std::round((last_col - first_col) * tile_scale) - 1., 1.), std::max(std::round((last_row - first_row) * tile_scale) - 1., 1.)
+  );
+  context->stroke();
+  context->restore();
+}
+
+bool BoardWidget::getMinimapArea(double &o_x, double &o_y, double &o_scale)
+{
+  const int \
+    width  = this->get_allocated_width(),
+    height = this->get_allocated_height();
+
+  if (this->minimap_rows == 0l || this->minimap_cols == 0l) return false;
+  if (this->h_adjustment->get_upper() <= width && this->v_adjustment->get_upper() <= height) return false;
+
+  o_scale = static_cast<double>(MINIMAP_SIZE) / std::max(this->minimap_rows, this->minimap_cols);
+  o_x = std::floor(width  - SPACING - this->minimap_cols * o_scale);
+  o_y = std::floor(height - SPACING - this->minimap_rows * o_scale);
+
+  return true;
+}
+
+bool BoardWidget::checkMinimapAt(double x, double y)
+{
+  double minimap_x, minimap_y, minimap_scale;
+  if (!this->getMinimapArea(minimap_x, minimap_y, minimap_scale)) return false;
+
+  return (
+    x >= minimap_x && x < minimap_x + this->minimap_cols * minimap_scale &&
+    y >= minimap_y && y < minimap_y + this->minimap_rows * minimap_scale
+  );
+}
+
+void BoardWidget::scrollToMinimap(double x, double y)
+{
+  double minimap_x, minimap_y, minimap_scale;
+  if (!this->getMinimapArea(minimap_x, minimap_y, minimap_scale)) return;
+
+  const double tile_scale = minimap_scale / this->minimap_block;
+
+  //! NOTE: set_value clamps to the scroll range
+  this->h_adjustment->set_value(this->toPixels((x - minimap_x) / tile_scale) - this->get_allocated_width()  / 2.);
+  this->v_adjustment->set_value(this->toPixels((y - minimap_y) / tile_scale) - this->get_allocated_height() / 2.);
+}
+
+/* #endregion */
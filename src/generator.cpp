@@ -0,0 +1,108 @@
+#include "generator.hpp"
+#include "logic.hpp"
+#include "solver.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+
+/* #region generation */
+
+NoGuessGenerator::NoGuessGenerator(index_t rows, index_t cols, double mine_density, index_t initial_patch_size, std::chrono::milliseconds time_budget):
+  rows(rows),
+  cols(cols),
+  mine_density(mine_density),
+  initial_patch_size(initial_patch_size),
+  time_budget(time_budget)
+{
+  MW_SET_CLASS_ORIGIN;
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "new with rows=" << rows << " cols=" << cols << " mine density=" << mine_density << " time budget=" << time_budget.count() << "ms";
+
+  this->nr_threads = std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+bool NoGuessGenerator::findSeed(index_t row, index_t col, seed_t base_seed, seed_t &o_seed, std::stop_token stop_token)
+{
+  MW_SET_FUNC_SCOPE;
+
+  const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + this->time_budget;
+
+  /**
+   * NOTE: Candidates are handed out in increasing order and a worker only stops early for candidates behind the
+   *       best one found so far. Once all workers are done, every candidate before the best one has been checked.
+   */
+  constexpr uint64_t no_candidate = std::numeric_limits<uint64_t>::max();
+  std::atomic<uint64_t> \
+    next_candidate_idx = 0ull,
+    best_candidate_idx = no_candidate;
+
+  std::stop_source stop_source;
+  {
+    std::stop_callback forward_stop(stop_token, [&stop_source]() { stop_source.request_stop(); });
+
+    std::vector<std::jthread> workers;
+    workers.reserve(this->nr_threads);
+    for (unsigned int worker_idx = 0u; worker_idx < this->nr_threads; worker_idx++)
+    {
+      workers.emplace_back(
+        [&, worker_token = stop_source.get_token()]()
+        {
+          Minefield candidate(this->rows, this->cols, base_seed);
+          candidate.setMineDensity(this->mine_density);
+          candidate.setInitialPatchSize(this->initial_patch_size);
+          Solver solver(candidate);
+          Minefield::cascade_t revealed_tiles;
+          bool has_revealed_mine;
+
+          while (!worker_token.stop_requested())
+          {
+            const uint64_t candidate_idx = next_candidate_idx.fetch_add(1ull, std::memory_order_relaxed);
+            if (candidate_idx >= best_candidate_idx.load(std::memory_order_relaxed)) break;
+
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+              stop_source.request_stop();
+              break;
+            }
+
+            candidate.reset(getCandidateSeed(base_seed, candidate_idx));
+            candidate.revealTile(row, col, revealed_tiles, has_revealed_mine);
+            solver.sync();
+            if (has_revealed_mine || !solver.solve()) continue;
+
+            uint64_t best_idx = best_candidate_idx.load(std::memory_order_relaxed);
+            while (candidate_idx < best_idx && !best_candidate_idx.compare_exchange_weak(best_idx, candidate_idx));
+          }
+        }
+      );
+    }
+  }
+
+  const uint64_t best_idx = best_candidate_idx.load();
+  MW_LOG(debug) << "checked " << std::min<uint64_t>(next_candidate_idx.load(), best_idx + 1ull) << " candidates";
+
+  if (best_idx == no_candidate || stop_token.stop_requested()) return false;
+
+  o_seed = getCandidateSeed(base_seed, best_idx);
+
+  return true;
+}
+
+/* #endregion */
+/* #region helpers */
+
+seed_t NoGuessGenerator::getCandidateSeed(seed_t base_seed, uint64_t candidate_idx)
+{
+  // the base seed itself is tried first, so an already guess free minefield stays the same
+  if (candidate_idx == 0ull) return base_seed;
+
+  return Xoshiro256(base_seed + candidate_idx)();
+}
+
+/* #endregion */
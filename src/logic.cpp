@@ -1,25 +1,34 @@
 #include "logic.hpp"
+#include "generator.hpp"
 
 #include <stdexcept>
 #include <random>
 #include <algorithm>
-#include <queue>
 #include <cassert>
 #include <numeric>
+#include <limits>
 #include <array>
 #include <set>
+#include <cstring>
+#include <bit>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+# include <immintrin.h>
+#endif //defined(__AVX2__) || defined(__SSE2__)
 
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 
 Minefield::tile_t Minefield::default_tile = Minefield::tile_t{};
 
-const std::array<Minefield::tile_offset_t, 8ul> Minefield::offsets = {{
-  {-1l, -1l}, { 0l, -1l}, { 1l, -1l},
-  {-1l,  0l},             { 1l,  0l},
-  {-1l,  1l}, { 0l,  1l}, { 1l,  1l},
-}};
+//! NOTE: flagged and revealed at the same time can't happen for a real tile, so every check that skips flagged or revealed tiles skips sentinels too
+const Minefield::tile_t Minefield::sentinel_tile = Minefield::tile_t{
+  .is_flagged = true,
+  .is_revealed = true,
+  .nr_surrounding_untouched = 0u
+};
 
 const std::array<Minefield::tile_offset_t, 4ul> Minefield::directions = {{
               { 0l, -1l},
@@ -31,10 +40,10 @@ const std::array<Minefield::tile_offset_t, 4ul> Minefield::directions = {{
 std::ostream &operator<<(std::ostream &stream, const Minefield::tile_t &tile)
 {
   stream << std::boolalpha << "{"
-    "is mine: " << tile.is_mine << "; "
+    "is mine: " << (bool)tile.is_mine << "; "
     "nr surrounding mines: " << (int)tile.nr_surrounding_mines << "; "
-    "is flagged: " << tile.is_flagged << "; "
-    "is revealed: " << tile.is_revealed << "; "
+    "is flagged: " << (bool)tile.is_flagged << "; "
+    "is revealed: " << (bool)tile.is_revealed << "; "
     "nr surrounding flags: " << (int)tile.nr_surrounding_flags << "; "
     "nr surrounding untouched: " << (int)tile.nr_surrounding_untouched << '}';
 
@@ -57,9 +66,21 @@ inline bool operator<(const Minefield::tile_position_t &left, const Minefield::t
 }
 
 
+/* #region neighbor visitors */
+
+template<tile_visitor<Minefield::tile_t> visitor_t>
+inline void Minefield::forSurroundingTiles(index_t idx, visitor_t &&visitor)
+{
+  for (const index_t &offset: this->neighbor_offsets)
+  {
+    visitor(this->field[idx + offset]);
+  }
+}
+
+/* #endregion */
 /* #region minefield generation */
 
-Minefield::Minefield(index_t rows, index_t cols):
+Minefield::Minefield(index_t rows, index_t cols, std::optional<seed_t> seed):
   current_field_size{rows, cols}
 {
   MW_SET_CLASS_ORIGIN;
@@ -68,14 +89,15 @@ Minefield::Minefield(index_t rows, index_t cols):
   MW_LOG(trace) << "new with rows=" << rows << " cols=" << cols;
 
   this->field_size = rows * cols;
-  this->field = std::vector<Minefield::tile_t>(this->field_size);
+  this->updateFieldLayout();
 
   this->nr_of_mines = this->calculateNrOfMines();
 
+  this->updateSeed(seed);
   this->field_initialized = false;
 }
 
-void Minefield::resize(index_t rows, index_t cols)
+void Minefield::resize(index_t rows, index_t cols, std::optional<seed_t> seed)
 {
   MW_SET_FUNC_SCOPE;
 
@@ -84,66 +106,120 @@ void Minefield::resize(index_t rows, index_t cols)
   this->current_field_size = {rows, cols};
 
   this->field_size = rows * cols;
-  this->field.resize(this->field_size);
+  this->updateFieldLayout();
 
   this->nr_of_mines = this->calculateNrOfMines();
 
+  this->updateSeed(seed);
   this->field_initialized = false;
 }
 
-void Minefield::reset()
+void Minefield::reset(std::optional<seed_t> seed)
 {
   MW_SET_FUNC_SCOPE;
 
   MW_LOG(trace) << "reset";
 
+  this->nr_of_mines = this->calculateNrOfMines();
+
+  this->updateSeed(seed);
   this->field_initialized = false;
 }
 
+void Minefield::setGenerationMode(GenerationMode mode)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "set generation mode to " << (mode == GenerationMode::NO_GUESS ? "no guess" : "random");
+
+  this->generation_mode = mode;
+}
+
+void Minefield::setCountKernel(CountKernel kernel)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "set count kernel to " << (kernel == CountKernel::BOX_SUM ? "box sum" : "scatter");
+
+  this->count_kernel = kernel;
+}
+
+void Minefield::setMineDensity(double mine_density)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "set mine density to " << mine_density;
+
+  this->mine_density = std::clamp(mine_density, 0., 1.);
+  if (!this->field_initialized) this->nr_of_mines = this->calculateNrOfMines();
+}
+
+void Minefield::setInitialPatchSize(index_t initial_patch_size)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "set initial patch size to " << initial_patch_size;
+
+  this->initial_patch_size = std::max(initial_patch_size, 1l);
+  if (!this->field_initialized) this->nr_of_mines = this->calculateNrOfMines();
+}
+
 void Minefield::initFields(index_t row, index_t col)
 {
   MW_SET_FUNC_SCOPE;
 
   MW_LOG(trace) << "initialize field from row=" << row << " col=" << col;
 
-  // setup random device
-  std::random_device random_device;
-  std::mt19937 mersenne_twister(random_device());
-  std::uniform_int_distribution<size_t> random_direction_idx(0ul, 3ul);
+  // setup random generator
+  Xoshiro256 random_generator(this->seed);
 
   // reset field
-  index_t tile_position_idx = 0l;
-  std::generate(
-    this->field.begin(), this->field.end(),
-    [&]()
-    {
-      assert(tile_position_idx < this->field_size);
+  this->revealed_tiles_count = 0l;
+  this->correctly_flagged_mines_count = 0l;
+  this->actionable_tiles_count = 0l;
+  this->border_tiles.clear();
+  this->is_border_listed.assign(this->field.size(), false);
+  this->border_tiles_prune_size = 0ul;
+  this->unrevealed_safe_tiles.clear();
+  this->has_unrevealed_safe_tiles = false;
 
-      tile_t tile;
-      const index_t \
-        row = tile_position_idx / this->current_field_size.cols,
-        col = tile_position_idx % this->current_field_size.cols;
-      uint8_t untouched_tiles_correction = 0u;
-      if (row == 0l || row == this->current_field_size.rows - 1) untouched_tiles_correction += 3u;
-      if (col == 0l || col == this->current_field_size.cols - 1) untouched_tiles_correction += 3u;
-      if (untouched_tiles_correction == 6u) untouched_tiles_correction = 5u;
-      tile.nr_surrounding_untouched -= untouched_tiles_correction;
+  /**
+   * NOTE: Rows are filled with plain stores. Only the first and last tile of a row and the sentinel ring need
+   *       different values, so they are fixed up afterwards instead of checking the position of every tile.
+   */
+  const index_t \
+    rows = this->current_field_size.rows,
+    cols = this->current_field_size.cols;
+  std::fill_n(this->field.begin(), this->field_stride, this->sentinel_tile);
+  std::fill_n(this->field.end() - this->field_stride, this->field_stride, this->sentinel_tile);
+  for (index_t row = 0l; row < rows; row++)
+  {
+    const index_t row_begin = this->getTileIndex(row, 0l);
 
-      tile_position_idx++;
+    // tiles on the border of the field have fewer surrounding tiles
+    const bool is_border_row = (row == 0l || row == rows - 1l);
+    tile_t tile;
+    tile.nr_surrounding_untouched = (is_border_row ? 5u : 8u);
+    std::fill_n(this->field.begin() + row_begin, cols, tile);
 
-      return tile;
-    }
-  );
+    tile.nr_surrounding_untouched = (is_border_row ? 3u : 5u);
+    this->field[row_begin] = this->field[row_begin + cols - 1l] = tile;
+
+    this->field[row_begin - 1l] = this->field[row_begin + cols] = this->sentinel_tile;
+  }
 
   // generate initial patch
+  const size_t initial_patch_size = std::min<size_t>(this->initial_patch_size, this->field_size);
   std::set<tile_position_t> initial_patch = {{tile_position_t{row, col}}};
-  while (initial_patch.size() < MIN_INITIAL_FIELDS)
+  while (initial_patch.size() < initial_patch_size)
   {
     std::set<tile_position_t> initial_patch_copy(initial_patch);
     for (const tile_position_t &tile: initial_patch_copy)
     {
-      const tile_offset_t &offset = this->directions[random_direction_idx(mersenne_twister)];
-      initial_patch.insert(tile_position_t{tile.row + offset.rows, tile.col + offset.cols});
+      const tile_offset_t &offset = this->directions[random_generator.uniform(3ull)];
+      const tile_position_t new_tile{tile.row + offset.rows, tile.col + offset.cols};
+
+      if (this->checkTilePositionValid(new_tile.row, new_tile.col)) initial_patch.insert(new_tile);
     }
   }
 
@@ -158,78 +234,374 @@ void Minefield::initFields(index_t row, index_t col)
   MW_LOG(debug) << patch.str();
 # endif //defined(MW_DEBUG)
 
-  // preparation for sampling
-  std::vector<tile_position_t> \
-    possible_mine_positions(this->field_size - initial_patch.size()),
-    mine_positions;
-  tile_position_idx = 0l;
-  std::generate(
-    possible_mine_positions.begin(), possible_mine_positions.end(),
-    [&]()
+  // preparation for sampling: mines are drawn as ranks among the tiles outside of the patch
+  std::vector<index_t> initial_patch_ranks;
+  initial_patch_ranks.reserve(initial_patch.size());
+  for (const tile_position_t &tile_pos: initial_patch)
+  {
+    // the set is ordered by row first, so the ranks come out sorted
+    initial_patch_ranks.push_back(tile_pos.row * this->current_field_size.cols + tile_pos.col);
+  }
+
+  const index_t \
+    possible_mines_count = this->field_size - static_cast<index_t>(initial_patch_ranks.size()),
+    mines_count = std::min(this->nr_of_mines, possible_mines_count);
+  // the patch can grow past its size, the counters and the win check have to use the mines actually placed
+  this->nr_of_mines = mines_count;
+  const auto getSampledTileIndex = [&](index_t rank) -> index_t
+  {
+    for (const index_t &patch_rank: initial_patch_ranks)
+    {
+      if (patch_rank > rank) break;
+      rank++;
+    }
+
+    return this->getTileIndex(rank / this->current_field_size.cols, rank % this->current_field_size.cols);
+  };
+
+  /**
+   * NOTE: Floyd's algorithm draws k distinct ranks out of m with exactly k random numbers and uses the is_mine
+   *       bits of the field as the set of already drawn ranks, so nothing but the field itself gets allocated.
+   *       For dense fields it is cheaper to draw the safe tiles instead and invert the selection afterwards.
+   */
+  const bool scatter_counts = (this->count_kernel == CountKernel::SCATTER);
+  const auto placeMine = [this, scatter_counts](index_t tile_idx)
+  {
+    this->field[tile_idx].is_mine = true;
+    if (!scatter_counts) return;
+
+    //! NOTE: counts spilling into the sentinel ring are never read
+    this->forSurroundingTiles(
+      tile_idx,
+      [](tile_t &surrounding_tile)
+      {
+        surrounding_tile.nr_surrounding_mines++;
+      }
+    );
+  };
+
+  const bool sample_safe_tiles = (2l * mines_count > possible_mines_count);
+  const index_t sample_count = (sample_safe_tiles ? possible_mines_count - mines_count : mines_count);
+  for (index_t upper_rank = possible_mines_count - sample_count; upper_rank < possible_mines_count; upper_rank++)
+  {
+    index_t sampled_tile_idx = getSampledTileIndex(static_cast<index_t>(random_generator.uniform(upper_rank)));
+    if (this->field[sampled_tile_idx].is_mine) sampled_tile_idx = getSampledTileIndex(upper_rank);
+
+    if (sample_safe_tiles)
+    {
+      this->field[sampled_tile_idx].is_mine = true;
+    }
+    else
+    {
+      placeMine(sampled_tile_idx);
+    }
+  }
+
+  if (sample_safe_tiles)
+  {
+    // the patch has to stay free as well, so mark it before inverting the selection
+    for (const tile_position_t &tile_pos: initial_patch)
+    {
+      this->getTile(tile_pos.row, tile_pos.col).is_mine = true;
+    }
+
+    for (index_t row = 0l; row < this->current_field_size.rows; row++)
     {
-      tile_position_t tile_position;
-      do
+      for (index_t tile_idx = this->getTileIndex(row, 0l); tile_idx <= this->getTileIndex(row, this->current_field_size.cols - 1l); tile_idx++)
       {
-        assert(tile_position_idx < this->field_size);
+        tile_t &tile = this->field[tile_idx];
 
-        tile_position = tile_position_t{
-          /*rows = */ tile_position_idx / this->current_field_size.cols,
-          /*cols = */ tile_position_idx % this->current_field_size.cols
-        };
-        tile_position_idx++;
+        if (tile.is_mine)
+        {
+          tile.is_mine = false;
+        }
+        else
+        {
+          placeMine(tile_idx);
+        }
       }
-      while (initial_patch.contains(tile_position));
+    }
+  }
+
+  if (!scatter_counts) this->countSurroundingMines();
 
-      return tile_position;
+  MW_LOG(debug) << "placed " << mines_count << " mines" << (sample_safe_tiles ? " by sampling safe tiles" : "");
+}
+
+void Minefield::countSurroundingMines()
+{
+  MW_SET_FUNC_SCOPE;
+
+  const index_t \
+    stride = this->field_stride,
+    padded_rows = static_cast<index_t>(this->field.size()) / stride;
+
+  // rolling window over the mine plane, the sentinel rows at the top and bottom never hold mines
+  std::vector<uint8_t> mine_rows(3ul * stride, 0u), column_sums(stride), counts(stride, 0u);
+  uint8_t \
+    *above   = mine_rows.data(),
+    *current = above + stride,
+    *below   = current + stride;
+
+  /**
+   * NOTE: Going through the bitfield members keeps the compiler from vectorizing the conversion loops, so the
+   *       tiles are handled as raw 16 bit words with masks derived from the bitfield layout instead.
+   */
+  const uint16_t \
+    default_bits = std::bit_cast<uint16_t>(tile_t{}),
+    mine_mask = std::bit_cast<uint16_t>(tile_t{.is_mine = true}) ^ default_bits,
+    count_mask = std::bit_cast<uint16_t>(tile_t{.nr_surrounding_mines = 15u}) ^ default_bits,
+    count_shift = static_cast<uint16_t>(std::countr_zero(count_mask));
+
+  const auto loadMineRow = [&](index_t padded_row, uint8_t *o_mines)
+  {
+    const tile_t *tile = this->field.data() + padded_row * stride;
+    for (index_t col = 0l; col < stride; col++)
+    {
+      o_mines[col] = ((std::bit_cast<uint16_t>(tile[col]) & mine_mask) != 0u);
     }
-  );
+  };
 
-  // sample mine indices
-  mine_positions.reserve(this->nr_of_mines);
-  std::sample(
-    possible_mine_positions.begin(), possible_mine_positions.end(),
-    std::back_inserter(mine_positions),
-    this->nr_of_mines,
-    mersenne_twister
-  );
+  loadMineRow(1l, current);
+  for (index_t padded_row = 1l; padded_row < padded_rows - 1l; padded_row++)
+  {
+    if (padded_row + 1l < padded_rows - 1l)
+    {
+      loadMineRow(padded_row + 1l, below);
+    }
+    else
+    {
+      std::memset(below, 0, stride);
+    }
 
-# ifdef MW_DEBUG
-  std::stringstream mines;
-  mines << "mines: ";
-  for (const tile_position_t& tile_pos: mine_positions)
+    sumSurroundingMines(above, current, below, column_sums.data(), counts.data(), stride);
+
+    tile_t *tile = this->field.data() + padded_row * stride;
+    for (index_t col = 1l; col < stride - 1l; col++)
+    {
+      const uint16_t bits = std::bit_cast<uint16_t>(tile[col]);
+      tile[col] = std::bit_cast<tile_t>(static_cast<uint16_t>((bits & ~count_mask) | (counts[col] << count_shift)));
+    }
+
+    std::swap(above, current);
+    std::swap(current, below);
+  }
+}
+
+void Minefield::sumSurroundingMines(const uint8_t *above, const uint8_t *current, const uint8_t *below, uint8_t *sums, uint8_t *o_counts, index_t width)
+{
+  /**
+   * NOTE: The sum is split into a vertical pass (column sums of the three rows) and a horizontal one (three
+   *       neighboring column sums minus the tile itself). Column sums are at most 3 and counts at most 8, so
+   *       both fit into bytes and the vector units can process 16 / 32 tiles per instruction.
+   */
+  index_t col = 0l;
+# if defined(__AVX2__)
+  for (; col + 32l <= width; col += 32l)
   {
-    mines << '(' << tile_pos.row << ", " << tile_pos.col << ") ";
+    const __m256i sum = _mm256_add_epi8(
+      _mm256_add_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(above + col)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(current + col))
+      ),
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(below + col))
+    );
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums + col), sum);
+  }
+# elif defined(__SSE2__)
+  for (; col + 16l <= width; col += 16l)
+  {
+    const __m128i sum = _mm_add_epi8(
+      _mm_add_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(above + col)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(current + col))
+      ),
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(below + col))
+    );
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(sums + col), sum);
+  }
+# endif //defined(__AVX2__) || defined(__SSE2__)
+  for (; col < width; col++)
+  {
+    sums[col] = above[col] + current[col] + below[col];
   }
-  MW_LOG(debug) << mines.str();
-# endif //defined(MW_DEBUG)
 
-  // apply mine indices
-  for (const tile_position_t &tile_pos : mine_positions)
+  col = 1l;
+# if defined(__AVX2__)
+  for (; col + 33l <= width; col += 32l)
+  {
+    const __m256i count = _mm256_sub_epi8(
+      _mm256_add_epi8(
+        _mm256_add_epi8(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums + col - 1l)),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums + col))
+        ),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sums + col + 1l))
+      ),
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(current + col))
+    );
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(o_counts + col), count);
+  }
+# elif defined(__SSE2__)
+  for (; col + 17l <= width; col += 16l)
   {
-    this->getTile(tile_pos.row, tile_pos.col).is_mine = true;
+    const __m128i count = _mm_sub_epi8(
+      _mm_add_epi8(
+        _mm_add_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(sums + col - 1l)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(sums + col))
+        ),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(sums + col + 1l))
+      ),
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(current + col))
+    );
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(o_counts + col), count);
+  }
+# endif //defined(__AVX2__) || defined(__SSE2__)
+  for (; col < width - 1l; col++)
+  {
+    o_counts[col] = sums[col - 1l] + sums[col] + sums[col + 1l] - current[col];
+  }
+}
+
+void Minefield::buildOpeningIndex()
+{
+  MW_SET_FUNC_SCOPE;
+
+  this->opening_labels.clear();
+  this->empty_tile_bits.clear();
+  this->empty_tile_ranks.clear();
+  this->opening_tiles.clear();
+  this->opening_offsets.assign(1ul, 0ul);
+  this->opening_flag_counts.clear();
+
+  // field indices are stored as 32 bit to keep the index small; huge fields fall back to flood filling
+  this->has_opening_index = (this->field.size() <= std::numeric_limits<uint32_t>::max());
+  if (!this->has_opening_index)
+  {
+    MW_LOG(warning) << "field too large for opening index";
+
+    return;
+  }
+
+  // rank index over the empty tiles, so only they need a label
+  const size_t nr_words = (this->field.size() + 63ul) / 64ul;
+  this->empty_tile_bits.resize(nr_words);
+  this->empty_tile_ranks.resize(nr_words);
+  uint32_t nr_empty_tiles = 0u;
+  for (size_t word_idx = 0ul; word_idx < nr_words; word_idx++)
+  {
+    const size_t \
+      word_begin = word_idx * 64ul,
+      word_end   = std::min(word_begin + 64ul, this->field.size());
+
+    uint64_t word = 0ull;
+    for (size_t idx = word_begin; idx < word_end; idx++)
+    {
+      const tile_t &tile = this->field[idx];
+      const bool is_sentinel = (tile.is_flagged && tile.is_revealed);
+      word |= static_cast<uint64_t>(!tile.is_mine && tile.nr_surrounding_mines == 0u && !is_sentinel) << (idx - word_begin);
+    }
+
+    this->empty_tile_bits[word_idx] = word;
+    this->empty_tile_ranks[word_idx] = nr_empty_tiles;
+    nr_empty_tiles += static_cast<uint32_t>(std::popcount(word));
+  }
+  this->opening_labels.assign(nr_empty_tiles, 0u);
 
-    for (const tile_offset_t &offset : this->offsets)
+  // tiles collected by the current opening, cleared again once it is done since border tiles can be shared
+  std::vector<bool> is_visited(this->field.size(), false);
+  std::vector<uint32_t> opening_stack;
+  for (index_t row = 0l; row < this->current_field_size.rows; row++)
+  {
+    for (index_t seed_idx = this->getTileIndex(row, 0l); seed_idx <= this->getTileIndex(row, this->current_field_size.cols - 1l); seed_idx++)
     {
-      index_t \
-        current_row = tile_pos.row + offset.rows,
-        current_col = tile_pos.col + offset.cols;
+      const tile_t &seed_tile = this->field[seed_idx];
+      if (seed_tile.is_mine || seed_tile.nr_surrounding_mines != 0u || this->getOpeningLabel(seed_idx) != 0u) continue;
+
+      const uint32_t label = static_cast<uint32_t>(this->opening_offsets.size());
+      const size_t opening_begin = this->opening_tiles.size();
+
+      // depth first search over the empty tiles, collecting the numbered border on the way
+      is_visited[seed_idx] = true;
+      opening_stack.push_back(static_cast<uint32_t>(seed_idx));
+      while (!opening_stack.empty())
+      {
+        const index_t current_idx = opening_stack.back();
+        opening_stack.pop_back();
+
+        for (const index_t &offset : this->neighbor_offsets)
+        {
+          const index_t neighbor_idx = current_idx + offset;
+          const tile_t &neighbor_tile = this->field[neighbor_idx];
+
+          if (neighbor_tile.is_flagged && neighbor_tile.is_revealed) continue; // sentinel
+          if (is_visited[neighbor_idx]) continue;
+
+          is_visited[neighbor_idx] = true;
+          if (neighbor_tile.nr_surrounding_mines != 0u)
+          {
+            this->opening_tiles.push_back(static_cast<uint32_t>(neighbor_idx));
+          }
+          else
+          {
+            opening_stack.push_back(static_cast<uint32_t>(neighbor_idx));
+          }
+        }
+        this->getOpeningLabel(current_idx) = label;
+        this->opening_tiles.push_back(static_cast<uint32_t>(current_idx));
+      }
+
+      for (size_t tile_idx = opening_begin; tile_idx < this->opening_tiles.size(); tile_idx++) is_visited[this->opening_tiles[tile_idx]] = false;
+      this->opening_offsets.push_back(this->opening_tiles.size());
+    }
+  }
+
+  this->opening_flag_counts.assign(this->opening_offsets.size() - 1ul, 0u);
+
+  MW_LOG(debug) << "indexed " << this->opening_flag_counts.size() << " openings with " << this->opening_tiles.size() << " tiles";
+}
+
+void Minefield::updateFieldLayout()
+{
+  this->field_stride = this->current_field_size.cols + 2l;
+  this->neighbor_offsets = {
+    -this->field_stride - 1l, -this->field_stride, -this->field_stride + 1l,
+    -1l,                                           1l,
+     this->field_stride - 1l,  this->field_stride,  this->field_stride + 1l
+  };
+
+  this->field.resize((this->current_field_size.rows + 2l) * this->field_stride);
+}
 
-      if (!this->checkTilePositionValid(current_row, current_col)) continue;
-      tile_t &current_tile = this->getTile(current_row, current_col);
+void Minefield::updateSeed(std::optional<seed_t> seed)
+{
+  MW_SET_FUNC_SCOPE;
 
-      current_tile.nr_surrounding_mines++;
+  if (seed.has_value())
+  {
+    this->seed = seed.value();
+  }
+  else
+  {
+    if (!this->seed_source.has_value())
+    {
+      this->seed_source.emplace((static_cast<seed_t>(std::random_device()()) << 32) | std::random_device()());
     }
+    this->seed = (*this->seed_source)();
   }
+
+  MW_LOG(debug) << "next minefield uses seed " << this->seed;
 }
 
 /* #endregion */
 /* #region field manipulation */
 
-bool Minefield::revealTile(index_t row, index_t col, cascade_t &o_revealed_fields, bool & o_has_revealed_mine)
+bool Minefield::placeMines(index_t row, index_t col, std::stop_token stop_token)
 {
   MW_SET_FUNC_SCOPE;
 
-  MW_LOG(trace) << "reveal @ row=" << row << " col=" << col;
+  MW_LOG(trace) << "place mines @ row=" << row << " col=" << col;
 
   if (!this->checkTilePositionValid(row, col))
   {
@@ -238,12 +610,47 @@ bool Minefield::revealTile(index_t row, index_t col, cascade_t &o_revealed_field
     return false;
   }
 
-  if (!this->field_initialized)
+  if (this->generation_mode == GenerationMode::NO_GUESS)
+  {
+    seed_t no_guess_seed;
+    if (NoGuessGenerator(this->current_field_size.rows, this->current_field_size.cols, this->mine_density, this->initial_patch_size).findSeed(row, col, this->seed, no_guess_seed, stop_token))
+    {
+      this->seed = no_guess_seed;
+    }
+    else if (stop_token.stop_requested())
+    {
+      MW_LOG(debug) << "search for a minefield without guessing got cancelled";
+
+      return false;
+    }
+    else
+    {
+      MW_LOG(warning) << "no minefield without guessing found in time, using a random one";
+    }
+  }
+
+  this->initFields(row, col);
+  this->buildOpeningIndex();
+  this->field_initialized = true;
+
+  return true;
+}
+
+bool Minefield::revealTile(index_t row, index_t col, cascade_t &o_revealed_fields, bool & o_has_revealed_mine)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "reveal @ row=" << row << " col=" << col;
+
+  if (!this->checkTilePositionValid(row, col))
   {
-    this->initFields(row, col);
-    this->field_initialized = true;
+    MW_LOG_INVALID_TILE;
+
+    return false;
   }
 
+  if (!this->field_initialized) this->placeMines(row, col);
+
   this->revealTileInternal(row, col, o_revealed_fields, o_has_revealed_mine);
 
   return true;
@@ -261,19 +668,30 @@ bool Minefield::undoTileReveal(index_t row, index_t col)
 
     return false;
   }
-  tile_t &tile = this->getTile(row, col);
+  const index_t tile_idx = this->getTileIndex(row, col);
+  tile_t &tile = this->field[tile_idx];
+
+  if (!tile.is_revealed)
+  {
+    return true;
+  }
 
   tile.is_revealed = false;
-  this->forSurroundingMines(
-    row, col,
-    [](tile_t &surrounding_tile, void *) -> bool
+  this->revealed_tiles_count -= !tile.is_mine;
+  this->actionable_tiles_count -= tile.is_actionable;
+  tile.is_actionable = false;
+  this->forSurroundingTiles(
+    tile_idx,
+    [this](tile_t &surrounding_tile)
     {
       surrounding_tile.nr_surrounding_untouched++;
-
-      return false;
+      this->updateTileActionable(surrounding_tile);
+      this->updateTileBorder(surrounding_tile);
     }
   );
 
+  if (this->has_unrevealed_safe_tiles && !tile.is_mine) this->unrevealed_safe_tiles.push_back(tile_idx);
+
   return true;
 }
 
@@ -289,7 +707,8 @@ bool Minefield::toggleTileFlag(index_t row, index_t col, bool &o_is_flagged)
 
     return false;
   }
-  tile_t &tile = this->getTile(row, col);
+  const index_t tile_idx = this->getTileIndex(row, col);
+  tile_t &tile = this->field[tile_idx];
 
   if (tile.is_revealed)
   {
@@ -299,20 +718,30 @@ bool Minefield::toggleTileFlag(index_t row, index_t col, bool &o_is_flagged)
   tile.is_flagged = !tile.is_flagged;
   o_is_flagged = (tile.is_flagged);
 
+  if (tile.is_mine)
+  {
+    this->correctly_flagged_mines_count += (o_is_flagged ? 1l : -1l);
+  }
+
+  // a flag on an empty tile stops cascades, so its opening can't be copied out as a whole anymore
+  if (this->field_initialized && this->has_opening_index && !tile.is_mine && tile.nr_surrounding_mines == 0u)
+  {
+    this->opening_flag_counts[this->getOpeningLabel(tile_idx) - 1u] += (o_is_flagged ? 1u : -1u);
+  }
+
   MW_LOG(debug) << "flag is now flagged: " << std::boolalpha << o_is_flagged;
 
-  this->forSurroundingMines(
-    row, col,
-    [](tile_t &surrounding_tile, void *user_data) -> bool
+  //! NOTE: (int)false = 0 -> offset = -1; (int)true = 1 -> 1
+  const int offset = 2 * static_cast<int>(o_is_flagged) - 1;
+  this->forSurroundingTiles(
+    tile_idx,
+    [this, offset](tile_t &surrounding_tile)
     {
-      //! NOTE: (int)false = 0 -> offset = -1; (int)true = 1 -> 1
-      const int8_t offset = 2 * (*static_cast<const int8_t *>(user_data)) - 1;
       surrounding_tile.nr_surrounding_flags += offset;
       surrounding_tile.nr_surrounding_untouched -= offset;
-
-      return false;
-    },
-    &o_is_flagged
+      this->updateTileActionable(surrounding_tile);
+      this->updateTileBorder(surrounding_tile);
+    }
   );
 
   return true;
@@ -322,181 +751,238 @@ void Minefield::revealTilesForUser(cascade_t &o_revealed_fields)
 {
   MW_SET_FUNC_SCOPE;
 
+  o_revealed_fields.clear();
+  if (!this->field_initialized) return;
+
   /**
-   * 1. generate list of all unrevealed tiles adjacent to revealed ones
-   * 2. iterate over those and check if revealing those would solve the problem
-   * 3. if none of those solve the problem, reveal any of them, remove it from list and repeat from 2.
+   * NOTE: Only safe tiles next to revealed numbers are considered, the one unlocking the most surrounding numbers
+   *       gets revealed, until there are moves available again. The border list is kept up to date by every move,
+   *       only tiles that left the border since its last pruning have to be skipped.
    */
-
-  bool has_moves_available;
-  do
+  std::vector<index_t> candidates;
+  cascade_t revealed_tiles;
+  bool has_revealed_mine;
+  while (this->actionable_tiles_count == 0l && !this->checkGameWon())
   {
-    for (index_t row = 0l; row < this->current_field_size.rows && !has_moves_available; row++)
+    candidates.clear();
+    for (const index_t border_idx: this->border_tiles)
     {
-      for (index_t col = 0l; col < this->current_field_size.cols && !has_moves_available; col++)
-      {
-        const tile_t &tile = this->getTile(row, col);
+      const tile_t &border_tile = this->field[border_idx];
+      if (!border_tile.is_revealed || border_tile.nr_surrounding_untouched == 0u) continue;
 
-        // only keep untouched tiles
-        const bool is_untouched = (tile.is_revealed || tile.is_mine || tile.is_flagged);
-        if (is_untouched || tile.nr_surrounding_untouched == 0u) continue;
+      for (const index_t offset: this->neighbor_offsets)
+      {
+        const tile_t &tile = this->field[border_idx + offset];
+        if (!tile.is_revealed && !tile.is_flagged && !tile.is_mine) candidates.push_back(border_idx + offset);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
 
-        this->forSurroundingMines(
-          row, col,
-          [](tile_t &tile, void *user_data) -> bool
-          {
-            tile.nr_surrounding_untouched--;
+    index_t best_idx = -1l;
+    int best_score = -1;
+    for (const index_t candidate_idx: candidates)
+    {
+      const int score = this->scoreHelpCandidate(candidate_idx);
+      if (score <= best_score) continue;
 
-            if (Minefield::checkTileHasAvailableMoves(tile))
-            {
-              *reinterpret_cast<bool *>(user_data) = true;
-            }
-          },
-          &has_moves_available
-        );
+      best_score = score;
+      best_idx = candidate_idx;
+    }
 
-        if (!has_moves_available)
+    // all tiles next to revealed numbers are mines, so the game can only continue somewhere else
+    if (best_idx < 0l)
+    {
+      if (!this->has_unrevealed_safe_tiles)
+      {
+        for (index_t idx = 0l; idx < static_cast<index_t>(this->field.size()); idx++)
         {
-          // TODO: undo
+          const tile_t &tile = this->field[idx];
+          if (!tile.is_revealed && !tile.is_mine) this->unrevealed_safe_tiles.push_back(idx);
         }
+        this->has_unrevealed_safe_tiles = true;
+      }
 
-        // TODO: HOW THE FUCK DO WE DETECT THE END OF THE LOOP?
+      // revealed tiles never come back without an undo, which lists them again
+      while (!this->unrevealed_safe_tiles.empty() && this->field[this->unrevealed_safe_tiles.back()].is_revealed) this->unrevealed_safe_tiles.pop_back();
+      for (auto safe_it = this->unrevealed_safe_tiles.rbegin(); best_idx < 0l && safe_it != this->unrevealed_safe_tiles.rend(); safe_it++)
+      {
+        const tile_t &tile = this->field[*safe_it];
+        if (!tile.is_revealed && !tile.is_flagged) best_idx = *safe_it;
       }
     }
+
+    if (best_idx < 0l)
+    {
+      MW_LOG(warning) << "no safe tile left to reveal";
+      break;
+    }
+
+    const tile_position_t tile_pos = this->getTilePosition(best_idx);
+    MW_LOG(trace) << "reveal row=" << tile_pos.row << " col=" << tile_pos.col << " with score " << best_score;
+
+    this->revealTileInternal(tile_pos.row, tile_pos.col, revealed_tiles, has_revealed_mine);
+    o_revealed_fields.insert(o_revealed_fields.end(), revealed_tiles.begin(), revealed_tiles.end());
   }
-  while (!has_moves_available);
 }
 
 void Minefield::revealTileInternal(index_t row, index_t col, std::vector<tile_with_position_t> &o_revealed_fields, bool &o_has_revealed_mine)
 {
   MW_SET_FUNC_SCOPE;
 
-  const tile_t &tile = this->getTile(row, col);
+  const index_t tile_idx = this->getTileIndex(row, col);
+  const tile_t &tile = this->field[tile_idx];
 
+  // by default we don't expect to hit a mine, if we hit one this will be overwritten
   o_has_revealed_mine = false;
-
-  // initialize queue for field cascade
   o_revealed_fields.clear();
-  std::queue<tile_position_t> field_queue;
+
   if (tile.is_revealed && tile.nr_surrounding_mines == tile.nr_surrounding_flags)
   {
     MW_LOG(trace) << "tile is revealed and satisfied";
 
-    index_t \
-      above = row - 1l,
-      below = row + 1l,
-      left  = col - 1l,
-      right = col + 1l;
-
-    field_queue.push(tile_position_t{above, left});
-    field_queue.push(tile_position_t{above, col});
-    field_queue.push(tile_position_t{above, right});
-    field_queue.push(tile_position_t{row,   left});
-    field_queue.push(tile_position_t{row,   right});
-    field_queue.push(tile_position_t{below, left});
-    field_queue.push(tile_position_t{below, col});
-    field_queue.push(tile_position_t{below, right});
+    for (const index_t &offset : this->neighbor_offsets)
+    {
+      if (this->revealCascade(tile_idx + offset, o_revealed_fields))
+      {
+        MW_LOG(trace) << "hit a mine";
+
+        o_has_revealed_mine = true;
+        break;
+      }
+    }
   }
   else if (!tile.is_revealed && !tile.is_flagged)
   {
     MW_LOG(trace) << "tile is not available for reveal";
 
-    field_queue.push(tile_position_t{row, col});
+    o_has_revealed_mine = this->revealCascade(tile_idx, o_revealed_fields);
   }
   else
   {
     MW_LOG(trace) << "nothing to reveal";
     MW_LOG(debug) << tile;
-
-    return;
   }
+}
 
-  // by default we don't expect to hit a mine, if we hit one this will be overwritten
-  do
-  {
-    // get queue element
-    tile_position_t current_tile_pos = std::move(field_queue.front());
-    field_queue.pop();
+bool Minefield::revealCascade(index_t idx, cascade_t &o_revealed_fields)
+{
+  const tile_t &tile = this->field[idx];
 
-    MW_LOG(trace) << "processing queue tile @ row=" << current_tile_pos.row << " col=" << current_tile_pos.col;
+  // also filters out the sentinel ring
+  if (tile.is_flagged || tile.is_revealed) return false;
 
-    if (!this->checkTilePositionValid(current_tile_pos.row, current_tile_pos.col)) continue;
-    tile_t &current_tile = this->getTile(current_tile_pos.row, current_tile_pos.col);
+  if (tile.is_mine || tile.nr_surrounding_mines != 0u)
+  {
+    this->revealSingleTile(idx, o_revealed_fields);
 
-    // check if we need to evaluate further
-    if (current_tile.is_flagged || current_tile.is_revealed) continue;
+    return tile.is_mine;
+  }
 
-    // should be revealed now
-    current_tile.is_revealed = true;
-    this->forSurroundingMines(
-      current_tile_pos.row, current_tile_pos.col,
-      [](tile_t &surrounding_tile, void *) -> bool
+  // the opening is known since generation, so unless a flag cuts through it, just copy it out
+  if (this->has_opening_index)
+  {
+    const uint32_t opening = this->getOpeningLabel(idx) - 1u;
+    if (this->opening_flag_counts[opening] == 0u)
+    {
+      const auto \
+        opening_begin = this->opening_tiles.begin() + this->opening_offsets[opening],
+        opening_end   = this->opening_tiles.begin() + this->opening_offsets[opening + 1ul];
+      for (auto it = opening_begin; it != opening_end; it++)
       {
-        surrounding_tile.nr_surrounding_untouched--;
-
-        return false;
+        const tile_t &current_tile = this->field[*it];
+        if (!current_tile.is_flagged && !current_tile.is_revealed) this->revealSingleTile(*it, o_revealed_fields);
       }
-    );
 
-    // check if we hit a mine
-    if (current_tile.is_mine)
-    {
-      MW_LOG(trace) << "hit a mine";
+      return false;
+    }
+  }
 
-      o_has_revealed_mine = true;
-      o_revealed_fields.push_back(tile_with_position_t{current_tile_pos.row, current_tile_pos.col, -1});
+  /**
+   * NOTE: scanline flood fill over the empty area; every run of empty tiles gets revealed as soon as it is found,
+   *       so no tile is queued twice and only the runs themselves end up in the work buffer
+   */
+  this->cascade_stack.clear();
+  this->pushCascadeSpan(idx, o_revealed_fields);
 
-      break;
-    }
-    else
-    {
-      MW_LOG(trace) << "hit normal tile";
-      o_revealed_fields.push_back(tile_with_position_t{current_tile_pos.row, current_tile_pos.col, current_tile.nr_surrounding_mines});
-    }
+  while (!this->cascade_stack.empty())
+  {
+    const cascade_span_t span = this->cascade_stack.back();
+    this->cascade_stack.pop_back();
 
-    // if we hit an "empty" (no adjacent mines) reveal, add all adjacent fields to the queue
-    if (current_tile.nr_surrounding_mines == 0)
+    // tiles diagonal to the ends of the run are adjacent as well
+    for (const index_t row_offset : {-this->field_stride, this->field_stride})
     {
-      MW_LOG(trace) << "adding new elements to queue";
-
-      index_t \
-        above = current_tile_pos.row - 1l,
-        below = current_tile_pos.row + 1l,
-        left  = current_tile_pos.col - 1l,
-        right = current_tile_pos.col + 1l;
-
-      field_queue.push(tile_position_t{above, left});
-      field_queue.push(tile_position_t{above, current_tile_pos.col});
-      field_queue.push(tile_position_t{above, right});
-      field_queue.push(tile_position_t{current_tile_pos.row, left});
-      field_queue.push(tile_position_t{current_tile_pos.row, right});
-      field_queue.push(tile_position_t{below, left});
-      field_queue.push(tile_position_t{below, current_tile_pos.col});
-      field_queue.push(tile_position_t{below, right});
+      const index_t last_idx = span.right + 1l + row_offset;
+      for (index_t current_idx = span.left - 1l + row_offset; current_idx <= last_idx; current_idx++)
+      {
+        const tile_t &current_tile = this->field[current_idx];
+        if (current_tile.is_flagged || current_tile.is_revealed) continue;
+
+        // neighbors of empty tiles are never mines
+        if (current_tile.nr_surrounding_mines != 0u)
+        {
+          this->revealSingleTile(current_idx, o_revealed_fields);
+        }
+        else
+        {
+          current_idx = this->pushCascadeSpan(current_idx, o_revealed_fields);
+        }
+      }
     }
-  } while (!field_queue.empty());
+  }
 
-  return;
+  return false;
 }
 
-void Minefield::forSurroundingMines(index_t row, index_t col, for_surrounding_tiles_callback_t callback, void *user_data)
+index_t Minefield::pushCascadeSpan(index_t seed_idx, cascade_t &o_revealed_fields)
 {
-  MW_SET_FUNC_SCOPE;
+  const auto is_cascading = [](const tile_t &tile) -> bool
+  {
+    return !tile.is_flagged && !tile.is_revealed && tile.nr_surrounding_mines == 0u;
+  };
 
-  MW_LOG(trace) << "iterating around row=" << row << " col=" << col;
+  cascade_span_t span{seed_idx, seed_idx};
+  while (is_cascading(this->field[span.left - 1l])) span.left--;
+  while (is_cascading(this->field[span.right + 1l])) span.right++;
 
-  for (const tile_offset_t& offset: this->offsets)
+  for (index_t current_idx = span.left; current_idx <= span.right; current_idx++)
   {
-    const index_t \
-      current_row = row + offset.rows,
-      current_col = col + offset.cols;
+    this->revealSingleTile(current_idx, o_revealed_fields);
+  }
 
-    if (!this->checkTilePositionValid(current_row, current_col)) continue;
+  // the run is bounded by numbers, flags, revealed tiles or sentinels; only the numbers still need revealing
+  for (const index_t border_idx : {span.left - 1l, span.right + 1l})
+  {
+    const tile_t &border_tile = this->field[border_idx];
+    if (!border_tile.is_flagged && !border_tile.is_revealed) this->revealSingleTile(border_idx, o_revealed_fields);
+  }
 
-    MW_LOG(trace) << "surrounding tile @ row=" << current_row << " col=" << current_col;
+  this->cascade_stack.push_back(span);
 
-    if (callback(this->getTile(current_row, current_col), user_data)) break;
-  }
+  return span.right;
+}
+
+inline void Minefield::revealSingleTile(index_t idx, cascade_t &o_revealed_fields)
+{
+  tile_t &tile = this->field[idx];
+
+  tile.is_revealed = true;
+  this->revealed_tiles_count += !tile.is_mine;
+  this->updateTileActionable(tile);
+  this->forSurroundingTiles(
+    idx,
+    [this](tile_t &surrounding_tile)
+    {
+      surrounding_tile.nr_surrounding_untouched--;
+      this->updateTileActionable(surrounding_tile);
+    }
+  );
+
+  this->updateTileBorder(tile);
+
+  const tile_position_t tile_pos = this->getTilePosition(idx);
+  o_revealed_fields.push_back(tile_with_position_t{tile_pos.row, tile_pos.col, (tile.is_mine ? -1 : tile.nr_surrounding_mines)});
 }
 
 /* #endregion */
@@ -506,46 +992,25 @@ bool Minefield::checkGameWon()
 {
   MW_SET_FUNC_SCOPE;
 
-  index_t \
-    revealed_tiles_count = 0l,
-    correctly_flagged_mines_count = 0l;
-  const index_t non_mine_tiles_count = this->field_size - this->nr_of_mines;
+  // nothing is placed before the first reveal, so there is nothing to win yet
+  if (!this->field_initialized) return false;
 
-  for (const tile_t &current_tile : this->field)
-  {
-    if (current_tile.is_revealed)
-    {
-      revealed_tiles_count++;
-    }
-    else if (current_tile.is_flagged && current_tile.is_mine)
-    {
-      correctly_flagged_mines_count++;
-    }
-  }
+  const index_t non_mine_tiles_count = this->field_size - this->nr_of_mines;
 
-  return (revealed_tiles_count == non_mine_tiles_count) || (correctly_flagged_mines_count == this->nr_of_mines);
+  return (this->revealed_tiles_count == non_mine_tiles_count) || (this->correctly_flagged_mines_count == this->nr_of_mines);
 }
 
 bool Minefield::checkHasAvailableMoves()
 {
   MW_SET_FUNC_SCOPE
 
-  // for (const tile_t &tile: this->field)
-  for (index_t idx = 0l; idx < this->field_size; idx++)
-  {
-    const tile_t &tile = this->field[idx];
-
-    if (
-      tile.is_flagged   ||
-      !tile.is_revealed ||
-      (tile.is_revealed && tile.nr_surrounding_mines == 0)
-    ) continue;
+  // before the first reveal any tile is a valid move
+  if (!this->field_initialized) return true;
 
-    if (this->checkTileHasAvailableMoves(tile))
-    {
-      MW_LOG(debug) << "moves available @ row=" << idx / this->current_field_size.cols << " cols=" << idx % this->current_field_size.cols;
-      return true;
-    }
+  if (this->actionable_tiles_count > 0l)
+  {
+    MW_LOG(debug) << "moves available @ " << this->actionable_tiles_count << " tiles";
+    return true;
   }
 
   MW_LOG(warning) << "No more available moves.";
@@ -553,6 +1018,11 @@ bool Minefield::checkHasAvailableMoves()
   return false;
 }
 
+bool Minefield::checkFieldInitialized()
+{
+  return this->field_initialized;
+}
+
 inline bool Minefield::checkTilePositionValid(index_t row, index_t col)
 {
   return (
@@ -569,6 +1039,38 @@ const index_t &Minefield::getNrMines()
   return this->nr_of_mines;
 }
 
+const field_size_t &Minefield::getFieldSize()
+{
+  return this->current_field_size;
+}
+
+seed_t Minefield::getSeed()
+{
+  return this->seed;
+}
+
+bool Minefield::getTileInfo(index_t row, index_t col, tile_info_t &o_info)
+{
+  if (!this->checkTilePositionValid(row, col))
+  {
+    MW_LOG_INVALID_TILE;
+
+    return false;
+  }
+  const tile_t &tile = this->getTile(row, col);
+
+  if (tile.is_revealed)
+  {
+    o_info = tile_info_t{TileState::REVEALED, (tile.is_mine ? -1 : tile.nr_surrounding_mines)};
+  }
+  else
+  {
+    o_info = tile_info_t{(tile.is_flagged ? TileState::FLAGGED : TileState::UNTOUCHED), 0};
+  }
+
+  return true;
+}
+
 #ifdef MW_DEBUG
 std::string Minefield::getTileString(index_t row, index_t col)
 {
@@ -602,14 +1104,105 @@ inline bool Minefield::checkTileHasAvailableMoves(const tile_t &tile)
   );
 }
 
+inline void Minefield::updateTileBorder(tile_t &tile)
+{
+  // flagged also covers the sentinel ring
+  if (!tile.is_revealed || tile.is_flagged || tile.is_mine || tile.nr_surrounding_mines == 0u || tile.nr_surrounding_untouched == 0u) return;
+
+  const index_t idx = &tile - this->field.data();
+  if (this->is_border_listed[idx]) return;
+
+  this->is_border_listed[idx] = true;
+  this->border_tiles.push_back(idx);
+  if (this->border_tiles.size() < this->border_tiles_prune_size) return;
+
+  std::erase_if(
+    this->border_tiles,
+    [this](index_t idx)
+    {
+      const tile_t &border_tile = this->field[idx];
+      const bool has_left_border = (!border_tile.is_revealed || border_tile.nr_surrounding_untouched == 0u);
+      if (has_left_border) this->is_border_listed[idx] = false;
+
+      return has_left_border;
+    }
+  );
+  this->border_tiles_prune_size = std::max(2ul * this->border_tiles.size(), 64ul);
+}
+
+inline int Minefield::scoreHelpCandidate(index_t idx)
+{
+  const tile_t &tile = this->field[idx];
+
+  // empty tiles set off a cascade, which leaves moves behind practically always
+  if (tile.nr_surrounding_mines == 0u) return std::numeric_limits<int>::max();
+
+  tile_t revealed_tile = tile;
+  revealed_tile.is_revealed = true;
+  int \
+    nr_unlocked = this->checkTileHasAvailableMoves(revealed_tile),
+    nr_revealed = 0;
+
+  this->forSurroundingTiles(
+    idx,
+    [&nr_unlocked, &nr_revealed](tile_t &surrounding_tile)
+    {
+      // flagged also covers the sentinel ring
+      if (!surrounding_tile.is_revealed || surrounding_tile.is_flagged || surrounding_tile.nr_surrounding_mines == 0u) return;
+
+      tile_t updated_tile = surrounding_tile;
+      updated_tile.nr_surrounding_untouched--;
+      nr_unlocked += (!surrounding_tile.is_actionable && Minefield::checkTileHasAvailableMoves(updated_tile));
+      nr_revealed++;
+    }
+  );
+
+  // prefer unlocking numbers, then tiles deep in the revealed area
+  return nr_unlocked * 16 + nr_revealed;
+}
+
+inline void Minefield::updateTileActionable(tile_t &tile)
+{
+  //! NOTE: most updates hit untouched or empty tiles, which never are actionable (see undoTileReveal)
+  if (!tile.is_revealed || tile.nr_surrounding_mines == 0u) return;
+
+  // flagged also covers the sentinel ring
+  const bool is_actionable = (
+    !tile.is_flagged &&
+    this->checkTileHasAvailableMoves(tile)
+  );
+  if (is_actionable == tile.is_actionable) return;
+
+  this->actionable_tiles_count += (is_actionable ? 1l : -1l);
+  tile.is_actionable = is_actionable;
+}
+
 inline index_t Minefield::calculateNrOfMines()
 {
-  return DEFAULT_BOMB_FACTOR * this->field_size;
+  // the initial patch has to stay free of mines
+  return std::min(static_cast<index_t>(this->mine_density * this->field_size), this->field_size - std::min(this->initial_patch_size, this->field_size));
 }
 
 inline Minefield::tile_t &Minefield::getTile(index_t row, index_t col)
 {
-  return this->field[row * this->current_field_size.cols + col];
+  return this->field[this->getTileIndex(row, col)];
+}
+
+inline index_t Minefield::getTileIndex(index_t row, index_t col)
+{
+  return (row + 1l) * this->field_stride + (col + 1l);
+}
+
+inline Minefield::tile_position_t Minefield::getTilePosition(index_t idx)
+{
+  return tile_position_t{idx / this->field_stride - 1l, idx % this->field_stride - 1l};
+}
+
+inline uint32_t &Minefield::getOpeningLabel(index_t idx)
+{
+  const uint64_t preceding_bits = this->empty_tile_bits[idx / 64l] & ((1ull << (idx % 64l)) - 1ull);
+
+  return this->opening_labels[this->empty_tile_ranks[idx / 64l] + std::popcount(preceding_bits)];
 }
 
 /* #endregion */
\ No newline at end of file
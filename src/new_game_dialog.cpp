@@ -32,19 +32,24 @@ NewGameDialog::NewGameDialog(Gtk::Window &parent):
   Gtk::Label *rows_label = Gtk::make_managed<Gtk::Label>("Rows: ", Gtk::ALIGN_START);
   base->attach(*rows_label, 0, 0);
   this->rows_widget.set_digits(0);
-  this->rows_widget.set_round_digits(0);
-  this->rows_widget.set_slider_size_fixed(true);
+  this->rows_widget.set_numeric(true);
+  this->rows_widget.set_increments(1., 10.);
+  this->rows_widget.set_range(MIN_FIELD_ROWS, MAX_FIELD_ROWS);
   this->rows_widget.set_hexpand(true);
   base->attach(this->rows_widget, 1, 0);
 
   Gtk::Label *cols_label = Gtk::make_managed<Gtk::Label>("Columns: ", Gtk::ALIGN_START);
   base->attach(*cols_label, 0, 1);
   this->cols_widget.set_digits(0);
-  this->cols_widget.set_round_digits(0);
-  this->cols_widget.set_slider_size_fixed(true);
+  this->cols_widget.set_numeric(true);
+  this->cols_widget.set_increments(1., 10.);
+  this->cols_widget.set_range(MIN_FIELD_COLS, MAX_FIELD_COLS);
   this->cols_widget.set_hexpand(true);
   base->attach(this->cols_widget, 1, 1);
 
+  this->no_guess_widget.set_label("Solvable without guessing");
+  base->attach(this->no_guess_widget, 0, 2, 2, 1);
+
   content_area->show_all();
 
   this->add_button(Gtk::Stock::OK,    Gtk::RESPONSE_OK);
@@ -52,18 +57,17 @@ NewGameDialog::NewGameDialog(Gtk::Window &parent):
   this->add_button(Gtk::Stock::CLOSE, Gtk::RESPONSE_CLOSE);
 }
 
-NewGameDialog::ReturnType NewGameDialog::run(Type type, index_t &io_rows, index_t max_rows, index_t &io_cols, index_t max_cols)
+NewGameDialog::ReturnType NewGameDialog::run(Type type, index_t &io_rows, index_t &io_cols, bool &io_no_guess)
 {
   MW_SET_FUNC_SCOPE;
 
   this->main_text.set_text(this->type2text.at(type));
 
-  this->rows_widget.set_range(MIN_FIELD_ROWS, (max_rows > MIN_FIELD_ROWS ? static_cast<double>(max_rows) : MIN_FIELD_ROWS));
   this->rows_widget.set_value(static_cast<double>(io_rows));
-
-  this->cols_widget.set_range(MIN_FIELD_ROWS, (max_cols > MIN_FIELD_COLS ? static_cast<double>(max_cols) : MIN_FIELD_COLS));
   this->cols_widget.set_value(static_cast<double>(io_cols));
 
+  this->no_guess_widget.set_active(io_no_guess);
+
   if (type == Type::LOSE)
   {
     this->undo_button->set_sensitive(true);
@@ -77,6 +81,7 @@ NewGameDialog::ReturnType NewGameDialog::run(Type type, index_t &io_rows, index_
 
   io_rows = static_cast<index_t>(this->rows_widget.get_value());
   io_cols = static_cast<index_t>(this->cols_widget.get_value());
+  io_no_guess = this->no_guess_widget.get_active();
 
   ReturnType result;
   switch (dialog_response)
@@ -0,0 +1,596 @@
+#include "probability_solver.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+
+/* #region probabilities */
+
+ProbabilitySolver::ProbabilitySolver(Minefield &minefield):
+  minefield(minefield)
+{
+  MW_SET_CLASS_ORIGIN;
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "new";
+}
+
+void ProbabilitySolver::sync()
+{
+  this->is_synced = false;
+}
+
+void ProbabilitySolver::notifyRevealed(const Minefield::cascade_t &revealed_tiles)
+{
+  if (!this->is_synced) return;
+
+  for (const Minefield::tile_with_position_t &tile: revealed_tiles)
+  {
+    this->updateTile(tile.row * this->field_size.cols + tile.col);
+  }
+}
+
+void ProbabilitySolver::notifyRevealUndone(index_t row, index_t col)
+{
+  if (!this->is_synced || row < 0l || row >= this->field_size.rows || col < 0l || col >= this->field_size.cols) return;
+
+  this->updateTile(row * this->field_size.cols + col);
+}
+
+void ProbabilitySolver::notifyFlagToggled(index_t row, index_t col)
+{
+  if (!this->is_synced || row < 0l || row >= this->field_size.rows || col < 0l || col >= this->field_size.cols) return;
+
+  this->updateTile(row * this->field_size.cols + col);
+}
+
+void ProbabilitySolver::rebuild()
+{
+  MW_SET_FUNC_SCOPE;
+
+  this->field_size = this->minefield.getFieldSize();
+  const index_t nr_tiles = this->field_size.rows * this->field_size.cols;
+
+  this->tile_infos.resize(nr_tiles);
+  this->nr_untouched_tiles = 0l;
+  this->nr_known_mines = 0l;
+  this->constraint_sources.clear();
+  this->is_constraint_source.assign(nr_tiles, false);
+  this->frontier_tiles.clear();
+  this->frontier_ids.assign(nr_tiles, -1l);
+
+  for (index_t board_idx = 0l; board_idx < nr_tiles; board_idx++)
+  {
+    Minefield::tile_info_t &info = this->tile_infos[board_idx];
+    this->minefield.getTileInfo(board_idx / this->field_size.cols, board_idx % this->field_size.cols, info);
+
+    this->nr_untouched_tiles += (info.state == Minefield::TileState::UNTOUCHED);
+    this->nr_known_mines += this->isKnownMine(info);
+    if (info.state == Minefield::TileState::REVEALED && info.type > 0)
+    {
+      this->is_constraint_source[board_idx] = true;
+      this->constraint_sources.push_back(board_idx);
+    }
+  }
+
+  this->is_synced = true;
+
+  MW_LOG(debug) << "queued " << this->constraint_sources.size() << " constraints";
+}
+
+bool ProbabilitySolver::computeProbabilities(std::vector<double> &o_probabilities)
+{
+  MW_SET_FUNC_SCOPE;
+
+  if (!this->is_synced) this->rebuild();
+  const index_t nr_tiles = this->field_size.rows * this->field_size.cols;
+
+  this->collectFrontier();
+  index_t nr_interior_tiles = this->nr_untouched_tiles - static_cast<index_t>(this->frontier_tiles.size());
+
+  std::vector<std::vector<size_t>> components, component_constraints;
+  this->splitComponents(components, component_constraints);
+
+  // enumerate the components, reusing the results of the ones that did not change since the last query
+  std::map<component_key_t, component_result_t> component_cache;
+  std::vector<const component_result_t *> component_results;
+  component_results.reserve(components.size());
+  size_t nr_reused = 0ul, nr_approximated = 0ul;
+  for (size_t component_idx = 0ul; component_idx < components.size(); component_idx++)
+  {
+    component_key_t key;
+    for (const size_t &tile: components[component_idx]) key.push_back(this->frontier_tiles[tile]);
+    key.push_back(-1l);
+    for (const size_t &constraint_idx: component_constraints[component_idx])
+    {
+      key.push_back(this->constraints[constraint_idx].source);
+      key.push_back(this->constraints[constraint_idx].nr_mines);
+    }
+
+    auto cached = this->component_cache.find(key);
+    if (cached != this->component_cache.end())
+    {
+      nr_reused++;
+      cached = component_cache.insert(this->component_cache.extract(cached)).position;
+    }
+    else
+    {
+      component_result_t result;
+      if (!this->enumerateComponent(components[component_idx], component_constraints[component_idx], result))
+      {
+        MW_LOG(warning) << "component without any solution";
+
+        return false;
+      }
+      cached = component_cache.emplace(std::move(key), std::move(result)).first;
+    }
+    component_results.push_back(&cached->second);
+
+    if (!cached->second.is_exact)
+    {
+      nr_approximated++;
+      nr_interior_tiles += static_cast<index_t>(components[component_idx].size());
+    }
+  }
+  this->component_cache = std::move(component_cache);
+
+  MW_LOG(debug) << components.size() << " components, " << nr_reused << " reused, " << nr_approximated << " approximated, " << nr_interior_tiles << " interior tiles";
+
+  /**
+   * NOTE: A combination of component solutions with K mines in total leaves the remaining mines to the interior,
+   *       which can hold them in C(interior, remaining) ways. These counts easily exceed the range of a double on
+   *       large fields, so all weights are combined as logarithms. The prefixes hold the weights of the components
+   *       before a component, the suffixes the weights of the components after it together with the interior. The
+   *       weight of a single component solution is thus combined from one prefix and one suffix, so every
+   *       component is only visited a constant number of times.
+   */
+  const index_t nr_mines_left = this->minefield.getNrMines() - this->nr_known_mines;
+  if (nr_mines_left < 0l) return false;
+
+  // log weight per number of mines in the components before each component, the last one covers the whole frontier
+  std::vector<std::vector<double>> \
+    component_log_weights(components.size()),
+    prefixes(components.size() + 1ul, std::vector<double>{0.});
+  for (size_t component_idx = 0ul; component_idx < components.size(); component_idx++)
+  {
+    for (const double &weight: component_results[component_idx]->weights) component_log_weights[component_idx].push_back(std::log(weight));
+    prefixes[component_idx + 1ul] = logConvolve(prefixes[component_idx], component_log_weights[component_idx]);
+  }
+
+  const std::vector<double> interior_log_weights = this->getInteriorLogWeights(nr_interior_tiles, nr_mines_left);
+  const auto getInteriorLogWeight = [&](index_t nr_interior_mines)
+  {
+    return (0l <= nr_interior_mines && nr_interior_mines <= nr_mines_left ? interior_log_weights[nr_interior_mines] : -INFINITY);
+  };
+
+  // log weight of the components from each component on plus the interior, per number of mines placed before it
+  std::vector<std::vector<double>> suffixes(components.size() + 1ul);
+  std::vector<double> log_terms;
+  suffixes.back().resize(prefixes.back().size());
+  for (index_t nr_frontier_mines = 0l; nr_frontier_mines < static_cast<index_t>(suffixes.back().size()); nr_frontier_mines++)
+  {
+    suffixes.back()[nr_frontier_mines] = getInteriorLogWeight(nr_mines_left - nr_frontier_mines);
+  }
+  for (size_t component_idx = components.size(); component_idx > 0ul; component_idx--)
+  {
+    const std::vector<double> \
+      &log_weights = component_log_weights[component_idx - 1ul],
+      &next_suffix = suffixes[component_idx];
+    std::vector<double> &suffix = suffixes[component_idx - 1ul];
+
+    suffix.resize(prefixes[component_idx - 1ul].size());
+    for (size_t nr_prior_mines = 0ul; nr_prior_mines < suffix.size(); nr_prior_mines++)
+    {
+      log_terms.clear();
+      for (size_t nr_component_mines = 0ul; nr_component_mines < log_weights.size(); nr_component_mines++)
+      {
+        log_terms.push_back(log_weights[nr_component_mines] + next_suffix[nr_prior_mines + nr_component_mines]);
+      }
+      suffix[nr_prior_mines] = logSumExp(log_terms);
+    }
+  }
+
+  const double log_total_weight = suffixes.front().front();
+  if (!std::isfinite(log_total_weight)) return false;
+
+  // expected number of interior mines over all solutions, spread evenly over the interior tiles
+  double interior_probability = 0.;
+  if (nr_interior_tiles > 0l)
+  {
+    const std::vector<double> &frontier_log_weights = prefixes.back();
+    log_terms.clear();
+    for (index_t nr_frontier_mines = 0l; nr_frontier_mines < static_cast<index_t>(frontier_log_weights.size()) && nr_frontier_mines < nr_mines_left; nr_frontier_mines++)
+    {
+      const index_t nr_interior_mines = nr_mines_left - nr_frontier_mines;
+      log_terms.push_back(frontier_log_weights[nr_frontier_mines] + getInteriorLogWeight(nr_interior_mines) + std::log(static_cast<double>(nr_interior_mines)));
+    }
+    interior_probability = std::exp(logSumExp(log_terms) - log_total_weight) / static_cast<double>(nr_interior_tiles);
+  }
+
+  o_probabilities.assign(nr_tiles, 0.);
+  for (index_t board_idx = 0l; board_idx < nr_tiles; board_idx++)
+  {
+    const Minefield::tile_info_t &info = this->tile_infos[board_idx];
+    if (this->isKnownMine(info))
+    {
+      o_probabilities[board_idx] = 1.;
+    }
+    else if (info.state == Minefield::TileState::UNTOUCHED && this->frontier_ids[board_idx] < 0l)
+    {
+      o_probabilities[board_idx] = interior_probability;
+    }
+  }
+
+  for (size_t component_idx = 0ul; component_idx < components.size(); component_idx++)
+  {
+    const component_result_t &result = *component_results[component_idx];
+    if (!result.is_exact)
+    {
+      for (const size_t &tile: components[component_idx]) o_probabilities[this->frontier_tiles[tile]] = interior_probability;
+      continue;
+    }
+
+    // share of the total weight of each number of mines inside the component, given everything outside of it
+    const std::vector<double> \
+      &prefix = prefixes[component_idx],
+      &suffix = suffixes[component_idx + 1ul];
+    const size_t nr_counts = result.weights.size();
+    std::vector<double> outside_weights(nr_counts);
+    for (size_t nr_component_mines = 0ul; nr_component_mines < nr_counts; nr_component_mines++)
+    {
+      log_terms.clear();
+      for (size_t nr_prior_mines = 0ul; nr_prior_mines < prefix.size(); nr_prior_mines++)
+      {
+        log_terms.push_back(prefix[nr_prior_mines] + suffix[nr_prior_mines + nr_component_mines]);
+      }
+      outside_weights[nr_component_mines] = std::exp(logSumExp(log_terms) - log_total_weight);
+    }
+
+    const std::vector<size_t> &tiles = components[component_idx];
+    for (size_t tile_idx = 0ul; tile_idx < tiles.size(); tile_idx++)
+    {
+      double mine_weight = 0.;
+      for (size_t nr_component_mines = 0ul; nr_component_mines < nr_counts; nr_component_mines++)
+      {
+        mine_weight += result.tile_weights[tile_idx * nr_counts + nr_component_mines] * outside_weights[nr_component_mines];
+      }
+      o_probabilities[this->frontier_tiles[tiles[tile_idx]]] = mine_weight;
+    }
+  }
+
+  return true;
+}
+
+/* #endregion */
+/* #region frontier */
+
+void ProbabilitySolver::updateTile(index_t board_idx)
+{
+  const index_t \
+    row = board_idx / this->field_size.cols,
+    col = board_idx % this->field_size.cols;
+
+  Minefield::tile_info_t info;
+  this->minefield.getTileInfo(row, col, info);
+
+  Minefield::tile_info_t &old_info = this->tile_infos[board_idx];
+  this->nr_untouched_tiles += static_cast<index_t>(info.state == Minefield::TileState::UNTOUCHED) - static_cast<index_t>(old_info.state == Minefield::TileState::UNTOUCHED);
+  this->nr_known_mines += static_cast<index_t>(this->isKnownMine(info)) - static_cast<index_t>(this->isKnownMine(old_info));
+  old_info = info;
+
+  // the tile itself and the numbers around it might constrain a different set of tiles now
+  for (index_t surrounding_row = std::max(row - 1l, 0l); surrounding_row <= std::min(row + 1l, this->field_size.rows - 1l); surrounding_row++)
+  {
+    for (index_t surrounding_col = std::max(col - 1l, 0l); surrounding_col <= std::min(col + 1l, this->field_size.cols - 1l); surrounding_col++)
+    {
+      const index_t surrounding_idx = surrounding_row * this->field_size.cols + surrounding_col;
+      const Minefield::tile_info_t &surrounding_info = this->tile_infos[surrounding_idx];
+      if (this->is_constraint_source[surrounding_idx] || surrounding_info.state != Minefield::TileState::REVEALED || surrounding_info.type <= 0) continue;
+
+      this->is_constraint_source[surrounding_idx] = true;
+      this->constraint_sources.push_back(surrounding_idx);
+    }
+  }
+}
+
+void ProbabilitySolver::collectFrontier()
+{
+  // only the tiles of the last frontier can be set
+  for (const index_t &board_idx: this->frontier_tiles) this->frontier_ids[board_idx] = -1l;
+
+  this->frontier_tiles.clear();
+  this->constraints.clear();
+  this->tile_constraints.clear();
+
+  size_t nr_kept_sources = 0ul;
+  for (const index_t board_idx: this->constraint_sources)
+  {
+    const Minefield::tile_info_t &info = this->tile_infos[board_idx];
+    if (info.state != Minefield::TileState::REVEALED || info.type <= 0)
+    {
+      this->is_constraint_source[board_idx] = false;
+      continue;
+    }
+
+    const index_t \
+      row = board_idx / this->field_size.cols,
+      col = board_idx % this->field_size.cols;
+
+    constraint_t constraint{.source = board_idx, .tiles = {}, .nr_mines = info.type};
+    for (index_t surrounding_row = std::max(row - 1l, 0l); surrounding_row <= std::min(row + 1l, this->field_size.rows - 1l); surrounding_row++)
+    {
+      for (index_t surrounding_col = std::max(col - 1l, 0l); surrounding_col <= std::min(col + 1l, this->field_size.cols - 1l); surrounding_col++)
+      {
+        const index_t surrounding_idx = surrounding_row * this->field_size.cols + surrounding_col;
+        if (this->isKnownMine(this->tile_infos[surrounding_idx]))
+        {
+          constraint.nr_mines--;
+        }
+        else if (this->tile_infos[surrounding_idx].state == Minefield::TileState::UNTOUCHED)
+        {
+          if (this->frontier_ids[surrounding_idx] < 0l)
+          {
+            this->frontier_ids[surrounding_idx] = static_cast<int64_t>(this->frontier_tiles.size());
+            this->frontier_tiles.push_back(surrounding_idx);
+            this->tile_constraints.emplace_back();
+          }
+          constraint.tiles.push_back(static_cast<size_t>(this->frontier_ids[surrounding_idx]));
+        }
+      }
+    }
+    if (constraint.tiles.empty())
+    {
+      // queued again once a surrounding tile gets unflagged or hidden
+      this->is_constraint_source[board_idx] = false;
+      continue;
+    }
+    this->constraint_sources[nr_kept_sources++] = board_idx;
+
+    for (const size_t &tile: constraint.tiles) this->tile_constraints[tile].push_back(this->constraints.size());
+    this->constraints.push_back(std::move(constraint));
+  }
+  this->constraint_sources.resize(nr_kept_sources);
+}
+
+void ProbabilitySolver::splitComponents(std::vector<std::vector<size_t>> &o_components, std::vector<std::vector<size_t>> &o_component_constraints)
+{
+  // union find over the frontier tiles, joined by the constraints they share
+  std::vector<size_t> parents(this->frontier_tiles.size());
+  std::iota(parents.begin(), parents.end(), 0ul);
+  const auto findRoot = [&parents](size_t tile)
+  {
+    while (parents[tile] != tile)
+    {
+      parents[tile] = parents[parents[tile]];
+      tile = parents[tile];
+    }
+    return tile;
+  };
+
+  for (const constraint_t &constraint: this->constraints)
+  {
+    for (const size_t &tile: constraint.tiles) parents[findRoot(tile)] = findRoot(constraint.tiles.front());
+  }
+
+  std::vector<int64_t> component_ids(this->frontier_tiles.size(), -1l);
+  o_components.clear();
+  o_component_constraints.clear();
+
+  // frontier tiles are numbered in the order they were found, so sort them to get the components sorted by board index
+  std::vector<size_t> sorted_tiles(this->frontier_tiles.size());
+  std::iota(sorted_tiles.begin(), sorted_tiles.end(), 0ul);
+  std::sort(sorted_tiles.begin(), sorted_tiles.end(), [this](size_t left, size_t right) { return this->frontier_tiles[left] < this->frontier_tiles[right]; });
+
+  this->component_tile_positions.resize(this->frontier_tiles.size());
+  for (const size_t &tile: sorted_tiles)
+  {
+    const size_t root = findRoot(tile);
+    if (component_ids[root] < 0l)
+    {
+      component_ids[root] = static_cast<int64_t>(o_components.size());
+      o_components.emplace_back();
+      o_component_constraints.emplace_back();
+    }
+    std::vector<size_t> &component = o_components[component_ids[root]];
+    this->component_tile_positions[tile] = component.size();
+    component.push_back(tile);
+  }
+
+  this->component_constraint_positions.resize(this->constraints.size());
+  for (size_t constraint_idx = 0ul; constraint_idx < this->constraints.size(); constraint_idx++)
+  {
+    std::vector<size_t> &component_constraints = o_component_constraints[component_ids[findRoot(this->constraints[constraint_idx].tiles.front())]];
+    this->component_constraint_positions[constraint_idx] = component_constraints.size();
+    component_constraints.push_back(constraint_idx);
+  }
+}
+
+bool ProbabilitySolver::enumerateComponent(const std::vector<size_t> &tiles, const std::vector<size_t> &constraint_ids, component_result_t &o_result)
+{
+  MW_SET_FUNC_SCOPE;
+
+  const size_t nr_counts = tiles.size() + 1ul;
+  o_result.weights.assign(nr_counts, 0.);
+  o_result.tile_weights.assign(tiles.size() * nr_counts, 0.);
+
+  // local views of the constraints: mines still needed and tiles still unassigned, indexed by their position
+  // within the component
+  std::vector<int> needed_mines;
+  std::vector<size_t> unassigned_tiles;
+  for (const size_t &constraint_idx: constraint_ids)
+  {
+    const constraint_t &constraint = this->constraints[constraint_idx];
+    if (constraint.nr_mines < 0 || constraint.nr_mines > static_cast<int>(constraint.tiles.size())) return false;
+
+    needed_mines.push_back(constraint.nr_mines);
+    unassigned_tiles.push_back(constraint.tiles.size());
+  }
+
+  /**
+   * NOTE: The tiles are assigned in breadth first order along the constraints, so constraints get closed early and
+   *       contradicting partial assignments are pruned close to where they occur.
+   */
+  std::vector<size_t> order, sorted_positions;
+  {
+    std::vector<bool> is_queued(tiles.size(), false);
+    order.push_back(tiles.front());
+    is_queued[0] = true;
+    for (size_t order_idx = 0ul; order_idx < order.size(); order_idx++)
+    {
+      for (const size_t &constraint_idx: this->tile_constraints[order[order_idx]])
+      {
+        for (const size_t &tile: this->constraints[constraint_idx].tiles)
+        {
+          const size_t position = this->component_tile_positions[tile];
+          if (is_queued[position]) continue;
+
+          is_queued[position] = true;
+          order.push_back(tile);
+        }
+      }
+    }
+
+    for (const size_t &tile: order) sorted_positions.push_back(this->component_tile_positions[tile]);
+  }
+
+  std::vector<bool> assignment(order.size(), false);
+  uint64_t nr_nodes = 0ull;
+  const auto recurse = [&](const auto &self, size_t depth, size_t nr_mines) -> void
+  {
+    if (++nr_nodes > PROBABILITY_MAX_ENUMERATION_NODES) return;
+
+    if (depth == order.size())
+    {
+      o_result.weights[nr_mines] += 1.;
+      for (size_t order_idx = 0ul; order_idx < order.size(); order_idx++)
+      {
+        if (assignment[order_idx]) o_result.tile_weights[sorted_positions[order_idx] * nr_counts + nr_mines] += 1.;
+      }
+      return;
+    }
+
+    const std::vector<size_t> &tile_constraints = this->tile_constraints[order[depth]];
+    for (const bool is_mine: {false, true})
+    {
+      const bool is_possible = std::all_of(
+        tile_constraints.begin(), tile_constraints.end(),
+        [&](size_t constraint_idx)
+        {
+          const size_t local_idx = this->component_constraint_positions[constraint_idx];
+          const int needed = needed_mines[local_idx] - static_cast<int>(is_mine);
+          return needed >= 0 && needed <= static_cast<int>(unassigned_tiles[local_idx]) - 1;
+        }
+      );
+      if (!is_possible) continue;
+
+      for (const size_t &constraint_idx: tile_constraints)
+      {
+        const size_t local_idx = this->component_constraint_positions[constraint_idx];
+        needed_mines[local_idx] -= static_cast<int>(is_mine);
+        unassigned_tiles[local_idx]--;
+      }
+      assignment[depth] = is_mine;
+
+      self(self, depth + 1ul, nr_mines + static_cast<size_t>(is_mine));
+
+      for (const size_t &constraint_idx: tile_constraints)
+      {
+        const size_t local_idx = this->component_constraint_positions[constraint_idx];
+        needed_mines[local_idx] += static_cast<int>(is_mine);
+        unassigned_tiles[local_idx]++;
+      }
+    }
+  };
+  recurse(recurse, 0ul, 0ul);
+
+  /**
+   * NOTE: The partial counts of an aborted enumeration are biased towards the tiles assigned first, so they are
+   *       dropped. The tiles of the component are treated like interior tiles instead, i.e. only the number of
+   *       mines left is taken into account for them.
+   */
+  if (nr_nodes > PROBABILITY_MAX_ENUMERATION_NODES)
+  {
+    MW_LOG(debug) << "aborted enumeration of " << tiles.size() << " tiles";
+
+    o_result = component_result_t{.weights = {1.}, .tile_weights = {}, .is_exact = false};
+    return true;
+  }
+
+  return std::any_of(o_result.weights.begin(), o_result.weights.end(), [](double weight) { return weight > 0.; });
+}
+
+/* #endregion */
+/* #region helpers */
+
+std::vector<double> ProbabilitySolver::getInteriorLogWeights(index_t nr_interior_tiles, index_t max_mines)
+{
+  // log(n!) is cached across queries
+  if (static_cast<index_t>(this->log_factorials.size()) <= nr_interior_tiles)
+  {
+    if (this->log_factorials.empty()) this->log_factorials.push_back(0.);
+    for (index_t n = static_cast<index_t>(this->log_factorials.size()); n <= nr_interior_tiles; n++)
+    {
+      this->log_factorials.push_back(this->log_factorials.back() + std::log(static_cast<double>(n)));
+    }
+  }
+
+  std::vector<double> log_weights(max_mines + 1l, -INFINITY);
+  const index_t max_valid_mines = std::min(max_mines, nr_interior_tiles);
+  for (index_t nr_mines = 0l; nr_mines <= max_valid_mines; nr_mines++)
+  {
+    log_weights[nr_mines] = this->log_factorials[nr_interior_tiles] - this->log_factorials[nr_mines] - this->log_factorials[nr_interior_tiles - nr_mines];
+  }
+
+  return log_weights;
+}
+
+inline bool ProbabilitySolver::isKnownMine(const Minefield::tile_info_t &info)
+{
+  return info.state == Minefield::TileState::FLAGGED || (info.state == Minefield::TileState::REVEALED && info.type < 0);
+}
+
+std::vector<double> ProbabilitySolver::logConvolve(const std::vector<double> &left, const std::vector<double> &right)
+{
+  // the largest term per sum is factored out first, so the exponentials stay in range
+  std::vector<double> result(left.size() + right.size() - 1ul, -INFINITY);
+  for (size_t left_idx = 0ul; left_idx < left.size(); left_idx++)
+  {
+    for (size_t right_idx = 0ul; right_idx < right.size(); right_idx++)
+    {
+      result[left_idx + right_idx] = std::max(result[left_idx + right_idx], left[left_idx] + right[right_idx]);
+    }
+  }
+
+  std::vector<double> sums(result.size(), 0.);
+  for (size_t left_idx = 0ul; left_idx < left.size(); left_idx++)
+  {
+    if (std::isinf(left[left_idx])) continue;
+
+    for (size_t right_idx = 0ul; right_idx < right.size(); right_idx++)
+    {
+      if (std::isinf(right[right_idx])) continue;
+
+      sums[left_idx + right_idx] += std::exp(left[left_idx] + right[right_idx] - result[left_idx + right_idx]);
+    }
+  }
+  for (size_t result_idx = 0ul; result_idx < result.size(); result_idx++)
+  {
+    if (!std::isinf(result[result_idx])) result[result_idx] += std::log(sums[result_idx]);
+  }
+
+  return result;
+}
+
+double ProbabilitySolver::logSumExp(const std::vector<double> &log_terms)
+{
+  const double max_log_term = (log_terms.empty() ? -INFINITY : *std::max_element(log_terms.begin(), log_terms.end()));
+  if (std::isinf(max_log_term)) return max_log_term;
+
+  double sum = 0.;
+  for (const double &log_term: log_terms) sum += std::exp(log_term - max_log_term);
+
+  return max_log_term + std::log(sum);
+}
+
+/* #endregion */
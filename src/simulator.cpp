@@ -0,0 +1,245 @@
+#include "simulator.hpp"
+#include "logic.hpp"
+#include "solver.hpp"
+#include "probability_solver.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+
+Simulator::Simulator(uint64_t nr_games, seed_t base_seed, unsigned int nr_threads):
+  nr_games(nr_games),
+  base_seed(base_seed),
+  nr_threads(nr_threads == 0u ? std::max(std::thread::hardware_concurrency(), 1u) : nr_threads),
+  task_queues(this->nr_threads)
+{
+  MW_SET_CLASS_ORIGIN;
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "new with games=" << nr_games << " seed=" << base_seed << " threads=" << this->nr_threads;
+}
+
+/* #region simulation */
+
+void Simulator::run(const std::vector<config_t> &configs, std::vector<result_t> &o_results, double &o_seconds)
+{
+  MW_SET_FUNC_SCOPE;
+
+  // hand the tasks out round robin, so every worker starts with a mix of all configurations
+  size_t queue_idx = 0ul;
+  for (size_t config_idx = 0ul; config_idx < configs.size(); config_idx++)
+  {
+    for (uint64_t first_game = 0ull; first_game < this->nr_games; first_game += SIMULATOR_GAMES_PER_TASK)
+    {
+      const task_t task{config_idx, first_game, std::min<uint64_t>(SIMULATOR_GAMES_PER_TASK, this->nr_games - first_game)};
+      this->task_queues[queue_idx].tasks.push_back(task);
+      queue_idx = (queue_idx + 1ul) % this->nr_threads;
+    }
+  }
+
+  // every worker collects its own results, so playing does not need any synchronization
+  std::vector<std::vector<result_t>> worker_results(this->nr_threads, std::vector<result_t>(configs.size()));
+
+  // minefields created without a seed would query the OS entropy, so every worker gets one drawn from the base seed
+  Xoshiro256 seed_source(this->base_seed);
+  std::vector<seed_t> worker_seeds(this->nr_threads);
+  for (seed_t &worker_seed: worker_seeds) worker_seed = seed_source();
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(this->nr_threads);
+    for (size_t worker_idx = 0ul; worker_idx < this->nr_threads; worker_idx++)
+    {
+      workers.emplace_back(
+        [this, worker_idx, &worker_seeds, &configs, &worker_results]()
+        {
+          this->work(worker_idx, worker_seeds[worker_idx], configs, worker_results[worker_idx]);
+        }
+      );
+    }
+  }
+  o_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  o_results.assign(configs.size(), result_t{});
+  for (const std::vector<result_t> &results: worker_results)
+  {
+    for (size_t config_idx = 0ul; config_idx < configs.size(); config_idx++)
+    {
+      const result_t &result = results[config_idx];
+      result_t &total = o_results[config_idx];
+
+      total.nr_games              += result.nr_games;
+      total.nr_wins               += result.nr_wins;
+      total.nr_wins_without_guess += result.nr_wins_without_guess;
+      total.nr_guesses            += result.nr_guesses;
+      total.nr_opening_tiles      += result.nr_opening_tiles;
+      total.min_opening_tiles      = std::min(total.min_opening_tiles, result.min_opening_tiles);
+      total.max_opening_tiles      = std::max(total.max_opening_tiles, result.max_opening_tiles);
+      total.cpu_seconds           += result.cpu_seconds;
+    }
+  }
+
+  MW_LOG(debug) << "played " << configs.size() << " configurations in " << o_seconds << "s";
+}
+
+unsigned int Simulator::getNrThreads()
+{
+  return this->nr_threads;
+}
+
+void Simulator::work(size_t worker_idx, seed_t worker_seed, const std::vector<config_t> &configs, std::vector<result_t> &o_results)
+{
+  MW_SET_FUNC_SCOPE;
+
+  task_t task;
+  while (this->popTask(worker_idx, task))
+  {
+    this->playGames(configs[task.config_idx], task, worker_seed, o_results[task.config_idx]);
+  }
+}
+
+bool Simulator::popTask(size_t worker_idx, task_t &o_task)
+{
+  {
+    task_queue_t &own_queue = this->task_queues[worker_idx];
+    std::lock_guard<std::mutex> lock(own_queue.mutex);
+    if (!own_queue.tasks.empty())
+    {
+      o_task = own_queue.tasks.back();
+      own_queue.tasks.pop_back();
+
+      return true;
+    }
+  }
+
+  //! NOTE: no tasks get added while running, so once every queue has been seen empty the worker is done
+  for (size_t offset = 1ul; offset < this->nr_threads; offset++)
+  {
+    task_queue_t &victim_queue = this->task_queues[(worker_idx + offset) % this->nr_threads];
+    std::lock_guard<std::mutex> lock(victim_queue.mutex);
+    if (!victim_queue.tasks.empty())
+    {
+      o_task = victim_queue.tasks.front();
+      victim_queue.tasks.pop_front();
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void Simulator::playGames(const config_t &config, const task_t &task, seed_t worker_seed, result_t &io_result)
+{
+  MW_SET_FUNC_SCOPE;
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  Minefield minefield(config.field_size.rows, config.field_size.cols, worker_seed);
+  minefield.setMineDensity(config.mine_density);
+  minefield.setInitialPatchSize(config.initial_patch_size);
+  Solver solver(minefield);
+  ProbabilitySolver probability_solver(minefield);
+
+  std::vector<double> probabilities;
+  Minefield::cascade_t revealed_tiles;
+  std::vector<Solver::tile_position_t> flagged_tiles;
+  Minefield::tile_info_t info;
+  bool has_revealed_mine;
+
+  for (uint64_t game_idx = task.first_game; game_idx < task.first_game + task.nr_games; game_idx++)
+  {
+    Xoshiro256 random_generator(this->base_seed + game_idx);
+    minefield.reset(random_generator());
+
+    index_t row, col;
+    this->getFirstClick(config, random_generator, row, col);
+    minefield.revealTile(row, col, revealed_tiles, has_revealed_mine);
+
+    const uint64_t nr_opening_tiles = revealed_tiles.size();
+    io_result.nr_opening_tiles += nr_opening_tiles;
+    io_result.min_opening_tiles = std::min(io_result.min_opening_tiles, nr_opening_tiles);
+    io_result.max_opening_tiles = std::max(io_result.max_opening_tiles, nr_opening_tiles);
+
+    solver.sync();
+    probability_solver.sync();
+    uint64_t nr_guesses = 0ull;
+    bool has_won;
+    while (!(has_won = solver.solve(revealed_tiles, flagged_tiles)))
+    {
+      probability_solver.notifyRevealed(revealed_tiles);
+      for (const Solver::tile_position_t &tile: flagged_tiles) probability_solver.notifyFlagToggled(tile.row, tile.col);
+
+      // guessing is required, so reveal the tile that is least likely to be a mine
+      if (!probability_solver.computeProbabilities(probabilities)) break;
+
+      index_t best_idx = -1l;
+      double best_probability = 2.;
+      for (index_t board_idx = 0l; board_idx < static_cast<index_t>(probabilities.size()); board_idx++)
+      {
+        if (probabilities[board_idx] >= best_probability) continue;
+
+        minefield.getTileInfo(board_idx / config.field_size.cols, board_idx % config.field_size.cols, info);
+        if (info.state != Minefield::TileState::UNTOUCHED) continue;
+
+        best_probability = probabilities[board_idx];
+        best_idx = board_idx;
+      }
+      if (best_idx < 0l) break;
+
+      nr_guesses++;
+      minefield.revealTile(best_idx / config.field_size.cols, best_idx % config.field_size.cols, revealed_tiles, has_revealed_mine);
+      if (has_revealed_mine) break;
+
+      solver.notifyRevealed(revealed_tiles);
+      probability_solver.notifyRevealed(revealed_tiles);
+    }
+
+    io_result.nr_games++;
+    io_result.nr_wins += has_won;
+    io_result.nr_wins_without_guess += (has_won && nr_guesses == 0ull);
+    io_result.nr_guesses += nr_guesses;
+  }
+
+  io_result.cpu_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* #endregion */
+/* #region helpers */
+
+void Simulator::getFirstClick(const config_t &config, Xoshiro256 &random_generator, index_t &o_row, index_t &o_col)
+{
+  const field_size_t &field_size = config.field_size;
+
+  switch (config.first_click)
+  {
+  case FirstClick::CENTER:
+    o_row = field_size.rows / 2l;
+    o_col = field_size.cols / 2l;
+    break;
+  case FirstClick::CORNER:
+    o_row = 0l;
+    o_col = 0l;
+    break;
+  case FirstClick::EDGE:
+    o_row = 0l;
+    o_col = field_size.cols / 2l;
+    break;
+  case FirstClick::RANDOM:
+    o_row = static_cast<index_t>(random_generator.uniform(field_size.rows - 1l));
+    o_col = static_cast<index_t>(random_generator.uniform(field_size.cols - 1l));
+    break;
+  default:
+    assert(false && "unknown first click position");
+
+    // keeps release builds on a valid tile
+    o_row = field_size.rows / 2l;
+    o_col = field_size.cols / 2l;
+    break;
+  }
+}
+
+/* #endregion */
@@ -0,0 +1,250 @@
+#include "simulator.hpp"
+
+#include "debug.hpp"
+
+#include <charconv>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <sysexits.h>
+
+
+/**
+ * @brief Print the command line usage.
+ *
+ * @param executable name the program was called with
+ */
+void printUsage(const char *executable)
+{
+  std::cerr
+    << "usage: " << executable << " [options]\n"
+    << "Play games with the built in solver and report win rates; lists are comma separated and all combinations get simulated.\n"
+    << "  --games N                  games per configuration (default: 1000)\n"
+    << "  --size ROWSxCOLS[,...]     field sizes (default: 16x30)\n"
+    << "  --density D[,...]          mines per tile (default: " << DEFAULT_BOMB_FACTOR << ")\n"
+    << "  --patch N[,...]            free tiles around the first click (default: " << MIN_INITIAL_FIELDS << ")\n"
+    << "  --first-click P[,...]      center, corner, edge or random (default: center)\n"
+    << "  --seed S                   seed the minefields are derived from (default: random)\n"
+    << "  --threads N                worker threads (default: one per core)\n";
+}
+
+/**
+ * @brief Split a comma separated list and parse its elements.
+ *
+ * @param list the list to split
+ * @param parse callable parsing a single element into the output vector, returning false if it is invalid
+ *
+ * @returns true if all elements were valid, false otherwise
+ */
+template<typename parser_t>
+bool parseList(std::string_view list, parser_t &&parse)
+{
+  while (true)
+  {
+    const size_t separator = list.find(',');
+    if (!parse(list.substr(0ul, separator))) return false;
+    if (separator == std::string_view::npos) return true;
+
+    list.remove_prefix(separator + 1ul);
+  }
+}
+
+/**
+ * @brief Parse a whole string as a number.
+ *
+ * @param text the string to parse
+ * @param o_value parsed number
+ *
+ * @returns true if the string is a valid number, false otherwise
+ */
+template<typename value_t>
+bool parseNumber(std::string_view text, value_t &o_value)
+{
+  const std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), o_value);
+
+  return (result.ec == std::errc() && result.ptr == text.data() + text.size());
+}
+
+
+int main(int argc, char *argv[])
+{
+# ifdef MW_DEBUG
+  // the core logs every move, which would drown the results
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::error);
+# endif // defined(MW_DEBUG)
+
+  uint64_t nr_games = 1000ull;
+  seed_t base_seed = (static_cast<seed_t>(std::random_device()()) << 32) | std::random_device()();
+  unsigned int nr_threads = 0u;
+  std::vector<field_size_t> field_sizes;
+  std::vector<double> mine_densities;
+  std::vector<index_t> initial_patch_sizes;
+  std::vector<Simulator::FirstClick> first_clicks;
+
+  for (int arg_idx = 1; arg_idx < argc; arg_idx++)
+  {
+    const std::string_view option = argv[arg_idx];
+    if (option == "--help" || option == "-h")
+    {
+      printUsage(argv[0]);
+
+      return EX_OK;
+    }
+    if (arg_idx + 1 >= argc)
+    {
+      std::cerr << "missing value for " << option << '\n';
+      printUsage(argv[0]);
+
+      return EX_USAGE;
+    }
+    const std::string_view value = argv[++arg_idx];
+
+    bool is_valid = false;
+    if (option == "--games")
+    {
+      is_valid = parseNumber(value, nr_games) && nr_games > 0ull;
+    }
+    else if (option == "--seed")
+    {
+      is_valid = parseNumber(value, base_seed);
+    }
+    else if (option == "--threads")
+    {
+      is_valid = parseNumber(value, nr_threads);
+    }
+    else if (option == "--size")
+    {
+      is_valid = parseList(
+        value,
+        [&field_sizes](std::string_view element) -> bool
+        {
+          const size_t separator = element.find('x');
+          field_size_t field_size;
+          if (separator == std::string_view::npos) return false;
+          if (!parseNumber(element.substr(0ul, separator), field_size.rows)) return false;
+          if (!parseNumber(element.substr(separator + 1ul), field_size.cols)) return false;
+          if (field_size.rows <= 0l || field_size.cols <= 0l) return false;
+
+          field_sizes.push_back(field_size);
+          return true;
+        }
+      );
+    }
+    else if (option == "--density")
+    {
+      is_valid = parseList(
+        value,
+        [&mine_densities](std::string_view element) -> bool
+        {
+          double mine_density;
+          if (!parseNumber(element, mine_density) || mine_density < 0. || mine_density >= 1.) return false;
+
+          mine_densities.push_back(mine_density);
+          return true;
+        }
+      );
+    }
+    else if (option == "--patch")
+    {
+      is_valid = parseList(
+        value,
+        [&initial_patch_sizes](std::string_view element) -> bool
+        {
+          index_t initial_patch_size;
+          if (!parseNumber(element, initial_patch_size) || initial_patch_size <= 0l) return false;
+
+          initial_patch_sizes.push_back(initial_patch_size);
+          return true;
+        }
+      );
+    }
+    else if (option == "--first-click")
+    {
+      is_valid = parseList(
+        value,
+        [&first_clicks](std::string_view element) -> bool
+        {
+          if      (element == "center") first_clicks.push_back(Simulator::FirstClick::CENTER);
+          else if (element == "corner") first_clicks.push_back(Simulator::FirstClick::CORNER);
+          else if (element == "edge")   first_clicks.push_back(Simulator::FirstClick::EDGE);
+          else if (element == "random") first_clicks.push_back(Simulator::FirstClick::RANDOM);
+          else return false;
+
+          return true;
+        }
+      );
+    }
+    else
+    {
+      std::cerr << "unknown option " << option << '\n';
+      printUsage(argv[0]);
+
+      return EX_USAGE;
+    }
+
+    if (!is_valid)
+    {
+      std::cerr << "invalid value '" << value << "' for " << option << '\n';
+
+      return EX_USAGE;
+    }
+  }
+
+  if (field_sizes.empty()) field_sizes.push_back(field_size_t{16l, 30l});
+  if (mine_densities.empty()) mine_densities.push_back(DEFAULT_BOMB_FACTOR);
+  if (initial_patch_sizes.empty()) initial_patch_sizes.push_back(MIN_INITIAL_FIELDS);
+  if (first_clicks.empty()) first_clicks.push_back(Simulator::FirstClick::CENTER);
+
+  std::vector<Simulator::config_t> configs;
+  for (const field_size_t &field_size: field_sizes)
+  {
+    for (const double mine_density: mine_densities)
+    {
+      for (const index_t initial_patch_size: initial_patch_sizes)
+      {
+        for (const Simulator::FirstClick first_click: first_clicks)
+        {
+          configs.push_back(Simulator::config_t{field_size, mine_density, initial_patch_size, first_click});
+        }
+      }
+    }
+  }
+
+  Simulator simulator(nr_games, base_seed, nr_threads);
+  std::vector<Simulator::result_t> results;
+  double seconds;
+  simulator.run(configs, results, seconds);
+
+  static const char *first_click_names[] = {"center", "corner", "edge", "random"};
+  std::cout
+    << "seed " << base_seed << ", " << nr_games << " games per configuration\n"
+    << std::setw(6) << "rows" << std::setw(6) << "cols" << std::setw(9) << "density" << std::setw(7) << "patch"
+    << std::setw(8) << "click" << std::setw(10) << "win rate" << std::setw(12) << "no guess" << std::setw(9) << "guesses"
+    << std::setw(10) << "opening" << std::setw(7) << "min" << std::setw(7) << "max" << std::setw(13) << "games/s/core" << '\n'
+    << std::fixed;
+  for (size_t config_idx = 0ul; config_idx < configs.size(); config_idx++)
+  {
+    const Simulator::config_t &config = configs[config_idx];
+    const Simulator::result_t &result = results[config_idx];
+    const double nr_games = static_cast<double>(result.nr_games);
+
+    std::cout
+      << std::setw(6) << config.field_size.rows << std::setw(6) << config.field_size.cols
+      << std::setw(9) << std::setprecision(4) << config.mine_density << std::setw(7) << config.initial_patch_size
+      << std::setw(8) << first_click_names[static_cast<int>(config.first_click)]
+      << std::setw(9) << std::setprecision(2) << 100. * result.nr_wins / nr_games << '%'
+      << std::setw(11) << std::setprecision(2) << 100. * result.nr_wins_without_guess / nr_games << '%'
+      << std::setw(9) << std::setprecision(3) << result.nr_guesses / nr_games
+      << std::setw(10) << std::setprecision(1) << result.nr_opening_tiles / nr_games
+      << std::setw(7) << result.min_opening_tiles << std::setw(7) << result.max_opening_tiles
+      << std::setw(13) << std::setprecision(1) << nr_games / result.cpu_seconds << '\n';
+  }
+
+  const double nr_total_games = static_cast<double>(nr_games * configs.size());
+  std::cout
+    << "played " << nr_games * configs.size() << " games in " << std::setprecision(3) << seconds << "s ("
+    << std::setprecision(1) << nr_total_games / seconds << " games/s on " << simulator.getNrThreads() << " threads)\n";
+
+  return EX_OK;
+}
@@ -0,0 +1,392 @@
+#include "solver.hpp"
+
+#include <algorithm>
+#include <bit>
+
+
+const std::array<Solver::tile_position_t, 8ul> Solver::neighbor_offsets = {{
+  {-1l, -1l}, {-1l,  0l}, {-1l,  1l},
+  { 0l, -1l},             { 0l,  1l},
+  { 1l, -1l}, { 1l,  0l}, { 1l,  1l}
+}};
+
+
+/* #region events */
+
+Solver::Solver(Minefield &minefield):
+  minefield(minefield)
+{
+  MW_SET_CLASS_ORIGIN;
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "new";
+
+  this->sync();
+}
+
+void Solver::sync()
+{
+  MW_SET_FUNC_SCOPE;
+
+  this->field_size = this->minefield.getFieldSize();
+  const size_t nr_tiles = static_cast<size_t>(this->field_size.rows * this->field_size.cols);
+
+  this->constraints.assign(nr_tiles, constraint_t{});
+  this->dirty_tiles.clear();
+  this->is_dirty.assign(nr_tiles, false);
+  this->subset_dirty_tiles.clear();
+  this->is_subset_dirty.assign(nr_tiles, false);
+  this->deductions.assign(nr_tiles, Deduction::UNKNOWN);
+  this->pending_safe_tiles.clear();
+  this->pending_mines.clear();
+
+  for (index_t board_idx = 0l; board_idx < static_cast<index_t>(nr_tiles); board_idx++)
+  {
+    if (this->getTileState(board_idx) == Minefield::TileState::REVEALED) this->markDirty(board_idx);
+  }
+
+  MW_LOG(debug) << "queued " << this->dirty_tiles.size() << " constraints";
+}
+
+void Solver::notifyRevealed(const Minefield::cascade_t &revealed_tiles)
+{
+  for (const Minefield::tile_with_position_t &tile: revealed_tiles)
+  {
+    this->markDirty(tile.row * this->field_size.cols + tile.col);
+  }
+}
+
+void Solver::notifyRevealUndone(index_t row, index_t col)
+{
+  if (!this->checkTilePositionValid(row, col)) return;
+
+  const index_t board_idx = row * this->field_size.cols + col;
+  this->deductions[board_idx] = Deduction::UNKNOWN;
+  this->markDirty(board_idx);
+}
+
+void Solver::notifyFlagToggled(index_t row, index_t col)
+{
+  if (!this->checkTilePositionValid(row, col)) return;
+
+  const index_t board_idx = row * this->field_size.cols + col;
+  this->deductions[board_idx] = Deduction::UNKNOWN;
+  this->markDirty(board_idx);
+}
+
+/* #endregion */
+/* #region solving */
+
+bool Solver::findMoves(std::vector<tile_position_t> &o_safe_tiles, std::vector<tile_position_t> &o_mines)
+{
+  MW_SET_FUNC_SCOPE;
+
+  // forget about the deductions that have been acted upon in the meantime
+  const auto isResolved = [this](index_t board_idx)
+  {
+    return this->getTileState(board_idx) != Minefield::TileState::UNTOUCHED;
+  };
+  std::erase_if(this->pending_safe_tiles, isResolved);
+  std::erase_if(this->pending_mines, isResolved);
+
+  /**
+   * NOTE: All dirty constraints get updated before any rule is applied, so the surrounding constraints a dirty one
+   *       is compared to are up to date as well. Pairs of clean constraints did not change, so they are skipped.
+   */
+  for (const index_t &board_idx: this->dirty_tiles)
+  {
+    this->is_dirty[board_idx] = false;
+    this->updateConstraint(board_idx);
+
+    if (!this->is_subset_dirty[board_idx])
+    {
+      this->is_subset_dirty[board_idx] = true;
+      this->subset_dirty_tiles.push_back(board_idx);
+    }
+  }
+
+  for (const index_t &board_idx: this->dirty_tiles)
+  {
+    if (this->constraints[board_idx].unknown_mask != 0u) this->applySinglePointRules(board_idx);
+  }
+
+  MW_LOG(debug) << "reevaluated " << this->dirty_tiles.size() << " constraints";
+  this->dirty_tiles.clear();
+
+  // the subset rules are a lot more expensive, so they are held back until the simple ones got stuck
+  if (this->pending_safe_tiles.empty() && this->pending_mines.empty())
+  {
+    this->applySubsetRulesToDirty();
+  }
+
+  const auto toPosition = [this](index_t board_idx)
+  {
+    return tile_position_t{board_idx / this->field_size.cols, board_idx % this->field_size.cols};
+  };
+
+  o_safe_tiles.clear();
+  std::transform(this->pending_safe_tiles.begin(), this->pending_safe_tiles.end(), std::back_inserter(o_safe_tiles), toPosition);
+  o_mines.clear();
+  std::transform(this->pending_mines.begin(), this->pending_mines.end(), std::back_inserter(o_mines), toPosition);
+
+  MW_LOG(debug) << "deduced " << o_safe_tiles.size() << " safe tiles and " << o_mines.size() << " mines";
+
+  return !o_safe_tiles.empty() || !o_mines.empty();
+}
+
+bool Solver::solve()
+{
+  Minefield::cascade_t revealed_tiles;
+  std::vector<tile_position_t> flagged_tiles;
+
+  return this->solve(revealed_tiles, flagged_tiles);
+}
+
+bool Solver::solve(Minefield::cascade_t &o_revealed_tiles, std::vector<tile_position_t> &o_flagged_tiles)
+{
+  MW_SET_FUNC_SCOPE;
+
+  o_revealed_tiles.clear();
+  o_flagged_tiles.clear();
+
+  std::vector<tile_position_t> safe_tiles, mines;
+  Minefield::cascade_t revealed_tiles;
+  Minefield::tile_info_t info;
+  bool has_revealed_mine, is_flagged;
+
+  while (this->findMoves(safe_tiles, mines))
+  {
+    for (const tile_position_t &tile: safe_tiles)
+    {
+      // an earlier cascade might have revealed it already
+      this->minefield.getTileInfo(tile.row, tile.col, info);
+      if (info.state != Minefield::TileState::UNTOUCHED) continue;
+
+      this->minefield.revealTile(tile.row, tile.col, revealed_tiles, has_revealed_mine);
+      if (has_revealed_mine)
+      {
+        // only possible if a flag was wrong
+        MW_LOG(warning) << "revealed mine @ row=" << tile.row << " col=" << tile.col;
+
+        return false;
+      }
+
+      this->notifyRevealed(revealed_tiles);
+      o_revealed_tiles.insert(o_revealed_tiles.end(), revealed_tiles.begin(), revealed_tiles.end());
+    }
+
+    for (const tile_position_t &tile: mines)
+    {
+      this->minefield.toggleTileFlag(tile.row, tile.col, is_flagged);
+      this->notifyFlagToggled(tile.row, tile.col);
+      o_flagged_tiles.push_back(tile);
+    }
+  }
+
+  return this->minefield.checkGameWon();
+}
+
+/* #endregion */
+/* #region rules */
+
+void Solver::markDirty(index_t board_idx)
+{
+  const index_t \
+    row = board_idx / this->field_size.cols,
+    col = board_idx % this->field_size.cols;
+
+  for (index_t surrounding_row = std::max(row - 1l, 0l); surrounding_row <= std::min(row + 1l, this->field_size.rows - 1l); surrounding_row++)
+  {
+    for (index_t surrounding_col = std::max(col - 1l, 0l); surrounding_col <= std::min(col + 1l, this->field_size.cols - 1l); surrounding_col++)
+    {
+      const index_t surrounding_idx = surrounding_row * this->field_size.cols + surrounding_col;
+      if (this->is_dirty[surrounding_idx]) continue;
+
+      this->is_dirty[surrounding_idx] = true;
+      this->dirty_tiles.push_back(surrounding_idx);
+    }
+  }
+}
+
+void Solver::updateConstraint(index_t board_idx)
+{
+  constraint_t &constraint = this->constraints[board_idx];
+  constraint = constraint_t{};
+
+  const index_t \
+    row = board_idx / this->field_size.cols,
+    col = board_idx % this->field_size.cols;
+
+  Minefield::tile_info_t info;
+  this->minefield.getTileInfo(row, col, info);
+  if (info.state != Minefield::TileState::REVEALED || info.type <= 0) return;
+
+  int8_t nr_mines = static_cast<int8_t>(info.type);
+  for (uint8_t direction = 0u; direction < 8u; direction++)
+  {
+    const tile_position_t &offset = this->neighbor_offsets[direction];
+    const index_t \
+      surrounding_row = row + offset.row,
+      surrounding_col = col + offset.col;
+    if (!this->checkTilePositionValid(surrounding_row, surrounding_col)) continue;
+
+    switch (this->getTileState(surrounding_row * this->field_size.cols + surrounding_col))
+    {
+    case Minefield::TileState::FLAGGED:
+      nr_mines--;
+      break;
+    case Minefield::TileState::UNTOUCHED:
+      constraint.unknown_mask |= static_cast<uint8_t>(1u << direction);
+      break;
+    default:
+      break;
+    }
+  }
+
+  constraint.nr_mines = nr_mines;
+}
+
+void Solver::applySubsetRulesToDirty()
+{
+  for (const index_t &board_idx: this->subset_dirty_tiles)
+  {
+    this->is_subset_dirty[board_idx] = false;
+    if (this->constraints[board_idx].unknown_mask == 0u) continue;
+
+    // constraints can only overlap if their sources are at most two tiles apart
+    const index_t \
+      row = board_idx / this->field_size.cols,
+      col = board_idx % this->field_size.cols;
+    for (index_t other_row = std::max(row - 2l, 0l); other_row <= std::min(row + 2l, this->field_size.rows - 1l); other_row++)
+    {
+      for (index_t other_col = std::max(col - 2l, 0l); other_col <= std::min(col + 2l, this->field_size.cols - 1l); other_col++)
+      {
+        const index_t other_idx = other_row * this->field_size.cols + other_col;
+        if (other_idx == board_idx || this->constraints[other_idx].unknown_mask == 0u) continue;
+
+        this->applySubsetRules(board_idx, other_idx);
+        this->applySubsetRules(other_idx, board_idx);
+      }
+    }
+  }
+
+  MW_LOG(debug) << "compared " << this->subset_dirty_tiles.size() << " constraints to their surroundings";
+  this->subset_dirty_tiles.clear();
+}
+
+void Solver::applySinglePointRules(index_t board_idx)
+{
+  const constraint_t &constraint = this->constraints[board_idx];
+
+  std::array<index_t, 8ul> tiles;
+  const uint8_t nr_tiles = this->getConstraintTiles(board_idx, tiles);
+
+  if (constraint.nr_mines == 0)
+  {
+    for (uint8_t tile_idx = 0u; tile_idx < nr_tiles; tile_idx++) this->deduce(tiles[tile_idx], Deduction::SAFE);
+  }
+  else if (constraint.nr_mines == nr_tiles)
+  {
+    for (uint8_t tile_idx = 0u; tile_idx < nr_tiles; tile_idx++) this->deduce(tiles[tile_idx], Deduction::MINE);
+  }
+}
+
+void Solver::applySubsetRules(index_t first_idx, index_t second_idx)
+{
+  // both constraints are laid out on a 7x7 area around the first source, so set operations become bit operations
+  const index_t \
+    row_offset = second_idx / this->field_size.cols - first_idx / this->field_size.cols,
+    col_offset = second_idx % this->field_size.cols - first_idx % this->field_size.cols;
+  const uint64_t \
+    first_area = this->getConstraintArea(first_idx, 0l, 0l),
+    second_area = this->getConstraintArea(second_idx, row_offset, col_offset);
+  if ((first_area & second_area) == 0ull) return;
+
+  const uint64_t \
+    first_only = first_area & ~second_area,
+    second_only = second_area & ~first_area;
+
+  /**
+   * NOTE: The shared tiles hold at most first.nr_mines mines, so the tiles only the second constraint sees hold
+   *       at least second.nr_mines - first.nr_mines. If that fills them up, the shared tiles have to hold all
+   *       mines of the first constraint and its exclusive tiles are safe (1-2 pattern). If the first constraint's
+   *       tiles are all shared and both need the same number of mines, the second's exclusive tiles are safe (1-1).
+   */
+  const int difference = this->constraints[second_idx].nr_mines - this->constraints[first_idx].nr_mines;
+  if (second_only != 0ull && difference == std::popcount(second_only))
+  {
+    this->deduceArea(first_idx, second_only, Deduction::MINE);
+    this->deduceArea(first_idx, first_only, Deduction::SAFE);
+  }
+  else if (first_only == 0ull && difference == 0)
+  {
+    this->deduceArea(first_idx, second_only, Deduction::SAFE);
+  }
+}
+
+inline void Solver::deduce(index_t board_idx, Deduction deduction)
+{
+  if (this->deductions[board_idx] != Deduction::UNKNOWN) return;
+
+  this->deductions[board_idx] = deduction;
+  (deduction == Deduction::SAFE ? this->pending_safe_tiles : this->pending_mines).push_back(board_idx);
+}
+
+inline void Solver::deduceArea(index_t center_idx, uint64_t area, Deduction deduction)
+{
+  for (; area != 0ull; area &= area - 1ull)
+  {
+    const index_t area_idx = std::countr_zero(area);
+    this->deduce(center_idx + (area_idx / 7l - 3l) * this->field_size.cols + (area_idx % 7l - 3l), deduction);
+  }
+}
+
+/* #endregion */
+/* #region helpers */
+
+inline uint8_t Solver::getConstraintTiles(index_t board_idx, std::array<index_t, 8ul> &o_tiles)
+{
+  const uint8_t unknown_mask = this->constraints[board_idx].unknown_mask;
+
+  uint8_t nr_tiles = 0u;
+  for (uint8_t direction = 0u; direction < 8u; direction++)
+  {
+    if ((unknown_mask & (1u << direction)) == 0u) continue;
+
+    const tile_position_t &offset = this->neighbor_offsets[direction];
+    o_tiles[nr_tiles++] = board_idx + offset.row * this->field_size.cols + offset.col;
+  }
+
+  return nr_tiles;
+}
+
+inline uint64_t Solver::getConstraintArea(index_t board_idx, index_t row_offset, index_t col_offset)
+{
+  const uint8_t unknown_mask = this->constraints[board_idx].unknown_mask;
+
+  uint64_t area = 0ull;
+  for (uint8_t direction = 0u; direction < 8u; direction++)
+  {
+    if ((unknown_mask & (1u << direction)) == 0u) continue;
+
+    const tile_position_t &offset = this->neighbor_offsets[direction];
+    area |= 1ull << ((offset.row + row_offset + 3l) * 7l + (offset.col + col_offset + 3l));
+  }
+
+  return area;
+}
+
+inline bool Solver::checkTilePositionValid(index_t row, index_t col)
+{
+  return 0l <= row && row < this->field_size.rows && 0l <= col && col < this->field_size.cols;
+}
+
+inline Minefield::TileState Solver::getTileState(index_t board_idx)
+{
+  Minefield::tile_info_t info;
+  this->minefield.getTileInfo(board_idx / this->field_size.cols, board_idx % this->field_size.cols, info);
+
+  return info.state;
+}
+
+/* #endregion */
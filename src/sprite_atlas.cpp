@@ -0,0 +1,72 @@
+#include "sprite_atlas.hpp"
+
+#include <algorithm>
+
+
+SpriteAtlas::SpriteAtlas(size_t capacity):
+  capacity(std::max(capacity, 1ul))
+{
+  MW_SET_CLASS_ORIGIN;
+  MW_SET_FUNC_SCOPE;
+}
+
+void SpriteAtlas::setSprites(const std::vector<sprite_t> &sprites)
+{
+  MW_SET_FUNC_SCOPE;
+
+  this->sprites = sprites;
+  this->atlases.clear();
+}
+
+Cairo::RefPtr<Cairo::ImageSurface> SpriteAtlas::getAtlas(int tile_size, int scale_factor)
+{
+  MW_SET_FUNC_SCOPE;
+
+  auto atlas_it = std::find_if(this->atlases.begin(), this->atlases.end(),
+    [tile_size, scale_factor](const atlas_t &atlas) { return atlas.tile_size == tile_size && atlas.scale_factor == scale_factor; }
+  );
+
+  if (atlas_it != this->atlases.end())
+  {
+    this->atlases.splice(this->atlases.begin(), this->atlases, atlas_it);
+  }
+  else
+  {
+    if (this->atlases.size() >= this->capacity) this->atlases.pop_back();
+
+    this->atlases.push_front(atlas_t{tile_size, scale_factor, this->createAtlas(tile_size, scale_factor)});
+  }
+
+  return this->atlases.front().surface;
+}
+
+Cairo::RefPtr<Cairo::ImageSurface> SpriteAtlas::createAtlas(int tile_size, int scale_factor)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(debug) << "creating atlas with tile size=" << tile_size << " scale factor=" << scale_factor;
+
+  const int sprite_size = tile_size * scale_factor;
+
+  Cairo::RefPtr<Cairo::ImageSurface> surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, sprite_size * static_cast<int>(this->sprites.size()), sprite_size);
+  Cairo::RefPtr<Cairo::Context> context = Cairo::Context::create(surface);
+
+  for (size_t sprite_idx = 0ul; sprite_idx < this->sprites.size(); sprite_idx++)
+  {
+    sprite_t sprite = this->sprites[sprite_idx];
+    if (sprite->get_width() != sprite_size || sprite->get_height() != sprite_size)
+    {
+      sprite = sprite->scale_simple(sprite_size, sprite_size, Gdk::INTERP_BILINEAR);
+    }
+
+    const double x = static_cast<double>(sprite_idx * sprite_size);
+    Gdk::Cairo::set_source_pixbuf(context, sprite, x, 0.);
+    context->rectangle(x, 0., sprite_size, sprite_size);
+    context->fill();
+  }
+
+  // painted in device pixels, drawn in logical ones
+  surface->set_device_scale(scale_factor, scale_factor);
+
+  return surface;
+}
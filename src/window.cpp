@@ -8,8 +8,8 @@
 #include <sysexits.h>
 
 
-Window::Window(Tile::callback_t tile_clicked_callback):
-  shared_tile_clicked_callback(tile_clicked_callback)
+Window::Window(BoardWidget::callback_t tile_clicked_callback):
+  field_widget(tile_clicked_callback)
 {
   MW_SET_CLASS_ORIGIN;
   MW_SET_FUNC_SCOPE;
@@ -30,21 +30,14 @@ Window::Window(Tile::callback_t tile_clicked_callback):
   base->set_border_width(SPACING);
   this->add(*base);
 
-  // add grid in scrolled window for field tiles
-  Gtk::ScrolledWindow *field_scroll_widget = Gtk::make_managed<Gtk::ScrolledWindow>();
-  field_scroll_widget->set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+  // add the board with its own scrollbars, it only ever draws the visible tiles
+  Gtk::Grid *field_scroll_widget = Gtk::make_managed<Gtk::Grid>();
   base->pack_start(*field_scroll_widget, Gtk::PACK_EXPAND_WIDGET);
 
-  Gtk::Box *v_allign_box = Gtk::make_managed<Gtk::Box>(Gtk::ORIENTATION_VERTICAL);
-  field_scroll_widget->add(*v_allign_box);
-
-  Gtk::Box *h_allign_box = Gtk::make_managed<Gtk::Box>(Gtk::ORIENTATION_HORIZONTAL);
-  v_allign_box->pack_start(*h_allign_box, Gtk::PACK_EXPAND_PADDING);
-
-  // this->field_widget = Gtk::Grid();
-  this->field_widget.set_row_spacing(SPACING);
-  this->field_widget.set_column_spacing(SPACING);
-  h_allign_box->pack_start(this->field_widget, Gtk::PACK_EXPAND_PADDING);
+  this->field_widget.setSprites(this->reveal_sprites, this->flagged_sprites, this->untouched_sprites);
+  field_scroll_widget->attach(this->field_widget, 0, 0);
+  field_scroll_widget->attach(*Gtk::make_managed<Gtk::Scrollbar>(this->field_widget.getVAdjustment(), Gtk::ORIENTATION_VERTICAL), 1, 0);
+  field_scroll_widget->attach(*Gtk::make_managed<Gtk::Scrollbar>(this->field_widget.getHAdjustment(), Gtk::ORIENTATION_HORIZONTAL), 0, 1);
 
   // add base box for buttons and info
   Gtk::Box *controls_box = Gtk::make_managed<Gtk::Box>(Gtk::ORIENTATION_VERTICAL, SPACING);
@@ -57,6 +50,14 @@ Window::Window(Tile::callback_t tile_clicked_callback):
   controls_box->pack_start(this->nr_bombs_widget, Gtk::PACK_SHRINK);
   this->restart_widget = Gtk::Button("Start new game");
   controls_box->pack_end(this->restart_widget, Gtk::PACK_SHRINK);
+  this->auto_play_widget.set_label("Auto play");
+  this->auto_play_widget.set_sensitive(false);
+  controls_box->pack_end(this->auto_play_widget, Gtk::PACK_SHRINK);
+  this->auto_play_rate_widget.set_range(0., 100000.);
+  this->auto_play_rate_widget.set_increments(1., 10.);
+  this->auto_play_rate_widget.set_value(AUTO_PLAY_MOVES_PER_SECOND);
+  this->auto_play_rate_widget.set_tooltip_text("Auto play moves per second, 0 for as fast as possible");
+  controls_box->pack_end(this->auto_play_rate_widget, Gtk::PACK_SHRINK);
 }
 
 void Window::bindRestartButtonCallback(const restart_button_callback_t &callback)
@@ -72,30 +73,56 @@ void Window::bindRestartButtonCallback(const restart_button_callback_t &callback
   restart_button_callback_connection = std::move(this->restart_widget.signal_clicked().connect(callback, true));
 }
 
+void Window::bindAutoPlayButtonCallback(const auto_play_button_callback_t &callback)
+{
+  MW_SET_FUNC_SCOPE;
+
+  MW_LOG(trace) << "changing auto play button callback";
+
+  this->auto_play_button_callback_connection.disconnect();
+  this->auto_play_rate_callback_connection.disconnect();
+
+  const auto relay = [this, callback]() -> void
+  {
+    callback(this->auto_play_widget.get_active(), this->auto_play_rate_widget.get_value_as_int());
+  };
+  this->auto_play_button_callback_connection = this->auto_play_widget.signal_toggled().connect(relay);
+  this->auto_play_rate_callback_connection = this->auto_play_rate_widget.signal_value_changed().connect(relay);
+
+  this->auto_play_widget.set_sensitive(true);
+}
+
+void Window::setAutoPlayActive(bool is_active)
+{
+  MW_SET_FUNC_SCOPE;
+
+  this->auto_play_widget.set_active(is_active);
+}
+
 
 #ifdef MW_DEBUG
 void Window::setTileDebugCallback(const sigc::slot<std::string, index_t, index_t> &callback)
 {
-  this->tile_information_callback = callback;
+  this->field_widget.setInformationCallback(callback);
 }
 #endif //!defined(MW_DEBUG)
 
-void Window::revealField(index_t row, index_t col, int as)
+void Window::applyCascade(const Minefield::cascade_t &cascade)
 {
   MW_SET_FUNC_SCOPE;
 
-  MW_LOG(trace) << "revealing field at row=" << row << " col=" << col;
+  MW_LOG(trace) << "revealing " << cascade.size() << " fields";
 
-  this->getTile(row, col)->revealAs(this->reveal_sprites.at(as + 1));
+  this->field_widget.revealTiles(cascade);
 }
 
-void Window::undoFieldReveal(index_t row, index_t col)
+void Window::undoCascade(const Minefield::cascade_t &cascade)
 {
   MW_SET_FUNC_SCOPE;
 
-  MW_LOG(trace) << "undoing field reveal at row=" << row << " col=" << col;
+  MW_LOG(trace) << "undoing reveal of " << cascade.size() << " fields";
 
-  this->getTile(row, col)->reset();
+  this->field_widget.resetTiles(cascade);
 }
 
 void Window::setFieldFlag(index_t row, index_t col, bool flag)
@@ -104,71 +131,17 @@ void Window::setFieldFlag(index_t row, index_t col, bool flag)
 
   MW_LOG(trace) << (flag ? "setting" : "unsetting") << " field at row=" << row << " col=" << col;
 
-  if (flag)
-  {
-    this->getTile(row, col)->flag();
-
-    this->current_mines++;
-    this->setMinesDisplay();
-  }
-  else
-  {
-    this->getTile(row, col)->reset();
+  this->field_widget.setTileFlag(row, col, flag);
 
-    this->current_mines--;
-    this->setMinesDisplay();
-  }
+  this->current_mines += (flag ? 1l : -1l);
+  this->setMinesDisplay();
 }
 
 void Window::generateMinefield(index_t rows, index_t cols, index_t nr_bombs)
 {
   MW_SET_FUNC_SCOPE;
 
-  const index_t  old_tile_count = this->current_field_size.rows * this->current_field_size.cols,
-                new_tile_count = rows * cols;
-
-  if (new_tile_count > old_tile_count)
-  {
-    for (index_t idx = old_tile_count; idx < new_tile_count; idx++)
-    {
-      Tile *new_tile = Gtk::make_managed<Tile>(this->shared_tile_clicked_callback, this->flagged_sprites, this->untouched_sprites);
-      this->field_widget.add(*new_tile);
-
-#     ifdef MW_DEBUG
-      new_tile->setInformationCallback(this->tile_information_callback);
-#     endif //defined(MW_DEBUG)
-    }
-  }
-  else
-  {
-    const std::vector<Gtk::Widget *> children = this->field_widget.get_children();
-    const auto end_it = children.begin() + (old_tile_count - new_tile_count);
-    for (auto it = children.begin(); it != end_it; it++)
-    {
-      Widget *widget = *it;
-      if (widget) this->field_widget.remove(*widget);
-    }
-  }
-
-  std::vector<Gtk::Widget *> children = this->field_widget.get_children();
-  for (index_t idx = 0l; idx < new_tile_count; idx++)
-  {
-    const index_t  row = idx / cols,
-                  col = idx % cols;
-
-    Tile *tile = static_cast<Tile *>(children.at(idx));
-    tile->setPosition(row, col);
-    tile->reset();
-
-    // a little bit of referencing magic so tiles can be reordered without being garbage collected
-    tile->reference();
-    this->field_widget.remove(*tile);
-    this->field_widget.attach(*tile, col, row);
-    tile->unreference();
-  }
-
-  this->field_widget.set_size_request(TILE_SIZE * cols, TILE_SIZE * rows);
-  this->field_widget.show_all_children();
+  this->field_widget.resize(rows, cols);
 
   this->current_max_mines = nr_bombs;
   this->current_field_size = {rows, cols};
@@ -181,28 +154,12 @@ void Window::resetMinefield()
 {
   MW_SET_FUNC_SCOPE;
 
-  for (Gtk::Widget *widget: this->field_widget.get_children())
-  {
-    static_cast<Tile *>(widget)->reset();
-  }
+  this->field_widget.reset();
 
   this->current_mines = 0l;
   this->setMinesDisplay();
 }
 
-field_size_t Window::getMaxFieldSize()
-{
-  MW_SET_FUNC_SCOPE;
-
-  Gtk::Box *base = static_cast<Gtk::Box *>(this->get_child());
-  Gtk::ScrolledWindow *scrolled_base = static_cast<Gtk::ScrolledWindow *>(base->get_children().at(0));
-
-  int width  = scrolled_base->get_width(),
-      height = scrolled_base->get_height();
-
-  return field_size_t{(height - SPACING) / (SPACING + TILE_SIZE), (width - SPACING) / (SPACING + TILE_SIZE)};
-}
-
 void Window::setMinesDisplay()
 {
   MW_SET_FUNC_SCOPE;
@@ -247,8 +204,3 @@ bool Window::loadSprites()
 
   return true;
 }
-
-inline Tile *Window::getTile(index_t row, index_t col)
-{
-  return static_cast<Tile *>(this->field_widget.get_child_at(col, row));
-}